@@ -0,0 +1,62 @@
+// Floating vs integer cost mode on the same mission: one findPath, then a series of replans
+// after random obstacle flips. Costs are scaled to 10/14 for both modes, so the two runs
+// solve the same problem and the difference is the open list and the key arithmetic.
+#include "DStarLite.h"
+#include "Grid.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    int size = argc > 1 ? std::atoi(argv[1]) : 1024;
+    int steps = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    std::cout << "grid " << size << "x" << size << ", ~10% obstacles, " << steps << " replans\n";
+
+    for (CostMode mode : {CostMode::Floating, CostMode::Integer}) {
+        Grid grid(size, size);
+        grid.setCostScale(10.0, 14.0);
+
+        std::mt19937 rng(42);
+        for (long long i = 0; i < static_cast<long long>(size) * size / 10; i++) 
+            grid.setWalkable(Node(rng() % size, rng() % size), false);
+
+        Node agent(0, 0);
+        Node goal(size - 1, size - 1);
+        grid.setWalkable(agent, true);
+        grid.setWalkable(goal, true);
+
+        DStarLite dstar(grid);
+        dstar.setCostMode(mode);
+
+        auto begin = Clock::now();
+        std::vector<Node> path = dstar.findPath(agent, goal);
+        double initial = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        long long initialExpansions = dstar.stats().expansions;
+
+        begin = Clock::now();
+        for (int step = 0; step < steps && path.size() > 1; step++) {
+            agent = path[1];
+
+            std::vector<Node> changes;
+            for (int i = 0; i < 20; i++) {
+                Node node(rng() % size, rng() % size);
+                if (node == agent || node == goal) continue;
+                grid.setWalkable(node, !grid.isWalkable(node));
+                changes.push_back(node);
+            }
+            path = dstar.notifyEnvironmentChanges(agent, changes);
+        }
+        double replans = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+        long long expansions = dstar.stats().expansions;
+        std::cout << (mode == CostMode::Integer ? "integer " : "floating") 
+                  << " initial=" << initial << "ms (" << initialExpansions << " expansions, " 
+                  << initial * 1e6 / initialExpansions << "ns each)"
+                  << " replans=" << replans << "ms (" << expansions - initialExpansions << " expansions)\n";
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Many agents sharing one goal: one FlowField against a DStarLite per agent. Reports the
+// field's build and repair times and the cost of stepping every agent once.
+#include "DStarLite.h"
+#include "FlowField.h"
+#include "Grid.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+
+static double since(Clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+}
+
+int main(int argc, char** argv) {
+    int size = argc > 1 ? std::atoi(argv[1]) : 512;
+    int agents = argc > 2 ? std::atoi(argv[2]) : 10000;
+    int plannedAgents = argc > 3 ? std::atoi(argv[3]) : 20;
+
+    Grid grid(size, size);
+    std::mt19937 rng(42);
+    for (long long i = 0; i < static_cast<long long>(size) * size / 10; i++)
+        grid.setWalkable(Node(rng() % size, rng() % size), false);
+
+    Node goal(size / 2, size / 2);
+    grid.setWalkable(goal, true);
+
+    std::vector<Node> positions;
+    while (static_cast<int>(positions.size()) < agents) {
+        Node node(rng() % size, rng() % size);
+        if (grid.isWalkable(node)) positions.push_back(node);
+    }
+
+    std::cout << "grid " << size << "x" << size << ", ~10% obstacles, " << agents << " agents\n";
+
+    auto begin = Clock::now();
+    FlowField field(grid, goal);
+    std::cout << "field build   : " << since(begin) << "ms expansions=" << field.expansions() << "\n";
+
+    long long before = field.expansions();
+    double repair = 0.0;
+    for (int step = 0; step < 50; step++) {
+        std::vector<Node> changes;
+        for (int i = 0; i < 20; i++) {
+            Node node(rng() % size, rng() % size);
+            if (node == goal) continue;
+            bool walkable = !grid.isWalkable(node);
+            grid.setWalkable(node, walkable);
+            changes.push_back(Node(node.row, node.col, walkable));
+        }
+
+        begin = Clock::now();
+        field.update(changes);
+        repair += since(begin);
+    }
+    std::cout << "field repair  : " << repair / 50 << "ms per 20 flips, expansions="
+              << (field.expansions() - before) / 50 << "\n";
+
+    begin = Clock::now();
+    long long moved = 0;
+    for (Node& agent : positions) {
+        Node next = field.nextStep(agent);
+        moved += next != agent;
+        agent = next;
+    }
+    double stepMs = since(begin);
+    std::cout << "field step    : " << stepMs * 1e6 / agents << "ns per agent, moved=" << moved << "\n";
+
+    // Per-agent planning, timed on a sample and scaled to the whole swarm.
+    begin = Clock::now();
+    for (int i = 0; i < plannedAgents; i++) {
+        DStarLite dstar(grid);
+        dstar.findPath(positions[i], goal);
+    }
+    double perAgent = since(begin) / plannedAgents;
+    std::cout << "dstar per agent: " << perAgent << "ms, ~" << perAgent * agents / 1000.0 << "s for the swarm\n";
+    return 0;
+}
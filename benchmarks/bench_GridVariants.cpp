@@ -0,0 +1,43 @@
+// Expansions and findPath time for the runtime Grid and the compile-time grid variants
+// on the same random obstacle map.
+#include "ConnectedGrid.h"
+#include "DStarLite.h"
+#include "Grid.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+template<typename G>
+static void run(const char* name, int size) {
+    G grid(size, size);
+    std::mt19937 rng(42);
+
+    for (int i = 0; i < size * size / 10; i++) 
+        grid.setWalkable(Node(rng() % size, rng() % size), false);
+    // Keep the corners open so every connectivity can leave them.
+    for (const Node& node : { Node(0, 0), Node(0, 1), Node(1, 0), 
+                              Node(size - 1, size - 1), Node(size - 1, size - 2), Node(size - 2, size - 1) }) 
+        grid.setWalkable(node, true);
+
+    DStarLite dstar(grid);
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<Node> path = dstar.findPath(Node(0, 0), Node(size - 1, size - 1));
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << name << ": path=" << path.size() 
+              << " expansions=" << dstar.stats().expansions 
+              << " time=" << std::chrono::duration<double, std::milli>(end - begin).count() << "ms\n";
+}
+
+int main(int argc, char** argv) {
+    int size = argc > 1 ? std::atoi(argv[1]) : 512;
+    std::cout << "grid " << size << "x" << size << ", ~10% obstacles\n";
+
+    run<Grid>("Grid   (octile)   ", size);
+    run<Grid8>("Grid8  (octile)   ", size);
+    run<Grid4>("Grid4  (manhattan)", size);
+    run<Grid16>("Grid16 (sqrt-free)", size);
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Compares the legacy Node hash with the packed-key hash on grid access patterns:
+// average/max chain length seen by successful lookups and lookup time.
+#include "DStarLite.h"
+#include "Grid.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+struct LegacyNodeHash {
+    std::size_t operator()(const Node& n) const {
+        return std::hash<int>{}(n.row) ^ (std::hash<int>{}(n.col) << 1);
+    }
+};
+
+struct PackedNodeHash {
+    std::size_t operator()(const Node& n) const {
+        return std::hash<Node>{}(n);
+    }
+};
+
+// Cells in the order a backward search from the grid centre touches them: rings of
+// increasing radius, each cell followed by its 8 neighbours.
+static std::vector<Node> searchPattern(int rows, int cols) {
+    std::vector<Node> nodes;
+    int cr = rows / 2, cc = cols / 2;
+
+    for (int radius = 0; radius < std::max(rows, cols) / 2; radius++) 
+        for (int r = cr - radius; r <= cr + radius; r++) 
+            for (int c = cc - radius; c <= cc + radius; c++) {
+                if (std::abs(r - cr) != radius && std::abs(c - cc) != radius) continue;
+                if (r < 0 || r >= rows || c < 0 || c >= cols) continue;
+
+                for (int dr = -1; dr <= 1; dr++) 
+                    for (int dc = -1; dc <= 1; dc++) 
+                        nodes.push_back(Node(r + dr, c + dc));
+            }
+
+    return nodes;
+}
+
+template<typename Hash>
+static void run(const char* name, const std::vector<Node>& pattern) {
+    std::unordered_map<Node, double, Hash> costs;
+    for (const Node& node : pattern) 
+        costs[node] = node.row + node.col;
+
+    // A successful lookup walks the chain of its bucket up to the key.
+    double totalProbes = 0.0;
+    std::size_t maxChain = 0;
+
+    for (const auto& [node, cost] : costs) {
+        std::size_t chain = costs.bucket_size(costs.bucket(node));
+        totalProbes += (chain + 1) / 2.0;
+        maxChain = std::max(maxChain, chain);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    double checksum = 0.0;
+
+    for (int repeat = 0; repeat < 5; repeat++) 
+        for (const Node& node : pattern) {
+            auto it = costs.find(node);
+            if (it != costs.end()) checksum += it->second;
+        }
+
+    auto end = std::chrono::steady_clock::now();
+    double nsPerLookup = std::chrono::duration<double, std::nano>(end - begin).count() / (5.0 * pattern.size());
+
+    std::cout << name << ": keys=" << costs.size() 
+              << " avgProbes=" << totalProbes / costs.size() 
+              << " maxChain=" << maxChain 
+              << " lookup=" << nsPerLookup << "ns"
+              << " (checksum " << checksum << ")\n";
+}
+
+int main(int argc, char** argv) {
+    int size = argc > 1 ? std::atoi(argv[1]) : 512;
+    std::vector<Node> pattern = searchPattern(size, size);
+
+    std::cout << "grid " << size << "x" << size << ", " << pattern.size() << " accesses\n";
+    run<LegacyNodeHash>("legacy row^(col<<1)", pattern);
+    run<PackedNodeHash>("packed key + mix  ", pattern);
+
+    Grid grid(size, size);
+    std::mt19937 rng(42);
+    for (int i = 0; i < size * size / 5; i++) 
+        grid.setWalkable(Node(rng() % size, rng() % size), false);
+    grid.setWalkable(Node(0, 0), true);
+    grid.setWalkable(Node(size - 1, size - 1), true);
+
+    DStarLite dstar(grid);
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<Node> path = dstar.findPath(Node(0, 0), Node(size - 1, size - 1));
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "findPath corner to corner: " << path.size() << " nodes in " 
+              << std::chrono::duration<double, std::milli>(end - begin).count() << "ms\n";
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Replays a recorded planner trace under several planner configurations and reports per-call
+// latency, expansions and memory for each, so backends can be compared on the same workload.
+// Without an argument a synthetic mission is recorded first (mission.dstr in the working
+// directory): random obstacles, an agent following its path, and random flips every step.
+#include "DStarLite.h"
+#include "Grid.h"
+#include "PlannerTrace.h"
+#include "SearchArena.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+    void recordMission(const std::string& path, int size, int steps) {
+        Grid grid(size, size);
+        std::mt19937 rng(42);
+        for (long long i = 0; i < static_cast<long long>(size) * size / 8; i++) 
+            grid.setWalkable(Node(rng() % size, rng() % size), false);
+
+        Node agent(0, 0);
+        Node goal(size - 1, size - 1);
+        grid.setWalkable(agent, true);
+        grid.setWalkable(goal, true);
+
+        DStarLite planner(grid);
+        TraceRecorder recorder(path, grid, planner);
+        std::vector<Node> route = recorder.findPath(agent, goal);
+
+        for (int step = 0; step < steps && route.size() > 1; step++) {
+            agent = route[1];
+
+            std::vector<Node> changes;
+            for (int i = 0; i < 20; i++) {
+                Node node(rng() % size, rng() % size);
+                if (node == agent || node == goal) continue;
+
+                bool walkable = !grid.isWalkable(node);
+                recorder.setWalkable(node, walkable);
+                changes.push_back(Node(node.row, node.col, walkable));
+            }
+            route = recorder.notifyEnvironmentChanges(agent, changes);
+        }
+    }
+
+    void report(const std::string& name, std::vector<ReplayCall> calls) {
+        double total = 0.0;
+        long long expansions = 0;
+        std::size_t maxState = 0;
+        std::size_t maxArena = 0;
+        for (const ReplayCall& call : calls) {
+            total += call.micros;
+            expansions += call.expansions;
+            maxState = std::max(maxState, call.stateSize);
+            maxArena = std::max(maxArena, call.arenaBytes);
+        }
+
+        std::sort(calls.begin(), calls.end(), [](const ReplayCall& a, const ReplayCall& b) { return a.micros < b.micros; });
+        auto percentile = [&](double p) { return calls.empty() ? 0.0 : calls[static_cast<std::size_t>(p * (calls.size() - 1))].micros; };
+
+        std::cout << name << ": calls=" << calls.size() << " total=" << total / 1000.0 << "ms"
+                  << " p50=" << percentile(0.5) << "us p99=" << percentile(0.99) << "us max=" << percentile(1.0) << "us"
+                  << " expansions=" << expansions << " maxState=" << maxState;
+        if (maxArena > 0) std::cout << " maxArena=" << maxArena / 1024 << "KiB";
+        std::cout << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "mission.dstr";
+    if (argc <= 1) recordMission(path, 512, 400);
+
+    PlannerTrace trace = PlannerTrace::load(path);
+    TraceReplayer replayer(trace);
+    std::cout << path << ": " << trace.rows << "x" << trace.cols << ", " << trace.events.size() << " events\n";
+
+    report("default       ", replayer.run());
+
+    SearchArena arena;
+    report("arena         ", replayer.run(nullptr, &arena));
+
+    report("integer 10/14 ", replayer.run([](Grid& grid, DStarLite& planner) {
+        grid.setCostScale(10.0, 14.0);
+        planner.setCostMode(CostMode::Integer);
+    }));
+
+    report("focus 32      ", replayer.run([](Grid&, DStarLite& planner) { planner.setFocusRadius(32.0); }));
+
+    report("budget 20000  ", replayer.run([](Grid&, DStarLite& planner) { planner.setMemoryBudget(20000); }));
+    return 0;
+}
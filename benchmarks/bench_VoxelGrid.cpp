@@ -0,0 +1,82 @@
+// Sparse voxel storage and D* Lite on a mostly empty size^3 volume (default 1024^3):
+// buildings are inserted as point clouds, then a replan after a scan blocks the route.
+#include "DStarLite.h"
+#include "VoxelGrid.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+
+static double millis(Clock::time_point begin, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+template<typename G>
+static void run(const char* name, int size) {
+    G grid(size, size, size);
+    std::mt19937 rng(42);
+
+    // Box-shaped buildings rising from the ground, sampled as a point cloud.
+    std::vector<SparseVoxelMap::Point> cloud;
+    for (int b = 0; b < size / 8; b++) {
+        int row = 32 + rng() % (size - 64);
+        int col = 32 + rng() % (size - 64);
+        int height = size / 8 + rng() % (size / 4);
+
+        for (int l = 0; l < height; l++)
+            for (int r = row; r < row + 8; r++)
+                for (int c = col; c < col + 8; c++)
+                    cloud.push_back({c + 0.5, r + 0.5, l + 0.5});
+    }
+
+    auto begin = Clock::now();
+    std::vector<Node> inserted = grid.insertPoints(cloud, 1.0);
+    auto end = Clock::now();
+
+    std::cout << name << ": inserted " << inserted.size() << " voxels in " << millis(begin, end) << "ms, "
+              << grid.getOccupancy().brickCount() << " bricks, "
+              << grid.getOccupancy().memoryBytes() / 1024 << " KiB\n";
+
+    DStarLite dstar(grid);
+    Node start(8, 8, 4, true);
+    Node goal(size - 8, size - 8, 12, true);
+
+    begin = Clock::now();
+    std::vector<Node> path = dstar.findPath(start, goal);
+    end = Clock::now();
+
+    std::cout << "  findPath: path=" << path.size() << " expansions=" << dstar.stats().expansions
+              << " time=" << millis(begin, end) << "ms\n";
+    if (path.size() < 2) return;
+
+    // A scan ahead of the agent finds a wall across the planned route.
+    Node agent = path[path.size() / 8];
+    Node ahead = path[path.size() / 8 + 16 < path.size() ? path.size() / 8 + 16 : path.size() - 1];
+    std::vector<SparseVoxelMap::Point> scan;
+    for (int dr = -16; dr <= 16; dr++)
+        for (int dl = 0; dl < 32; dl++)
+            scan.push_back({ahead.col + 0.5, ahead.row + dr + 0.5, dl + 0.5});
+
+    std::vector<Node> changes = grid.insertPoints(scan, 1.0);
+    dstar.resetStats();
+
+    begin = Clock::now();
+    path = dstar.notifyEnvironmentChanges(agent, changes);
+    end = Clock::now();
+
+    std::cout << "  replan:   changes=" << changes.size() << " path=" << path.size()
+              << " expansions=" << dstar.stats().expansions << " time=" << millis(begin, end) << "ms\n";
+}
+
+int main(int argc, char** argv) {
+    int size = argc > 1 ? std::atoi(argv[1]) : 1024;
+    std::cout << "volume " << size << "^3, dense bitmap would need " 
+              << (static_cast<long long>(size) * size * size / 8) / 1024 << " KiB\n";
+
+    run<VoxelGrid26>("VoxelGrid26", size);
+    run<VoxelGrid18>("VoxelGrid18", size);
+    run<VoxelGrid6>("VoxelGrid6 ", size);
+    return 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "DStarLite.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+struct PlannerUpdate {
+    Node agent;
+    std::vector<Node> changes; // each node's walkable flag is its new state
+
+    PlannerUpdate() {}
+    PlannerUpdate(const Node& agent, const std::vector<Node>& changes) : agent(agent), changes(changes) {}
+};
+
+// Runs DStarLite on a background thread. Once started, the planning thread owns the graph:
+// walkability changes must go through pushUpdate(), not IGraph::setWalkable().
+// Neither latestPath() nor pushUpdate() waits for a replan, but neither is lock-free: the
+// atomic shared_ptr load in latestPath() goes through the standard library's internal lock,
+// and pushUpdate() briefly takes the lock the idle planner sleeps on. Each published path is
+// a new allocation, made on the planning thread.
+class AsyncDStarLite {
+public:
+    AsyncDStarLite(IGraph& graph, std::size_t queueCapacity = 256);
+    ~AsyncDStarLite();
+
+    void setFocusRadius(double radius); // call before start()
+    void start(const Node& start, const Node& goal);
+    void stop();
+
+    bool pushUpdate(const Node& agentNode, const std::vector<Node>& updatedNodes); // false when the queue is full
+    std::shared_ptr<const std::vector<Node>> latestPath() const;
+    std::uint64_t pathVersion() const; // number of paths published so far
+private:
+    void run(Node start, Node goal);
+    void publish(std::vector<Node> path);
+    bool coalesceUpdates(Node& agentNode, std::vector<Node>& updatedNodes);
+private:
+    IGraph& graph;
+    DStarLite planner;
+    SpscQueue<PlannerUpdate> updates;
+
+    // Latest published path, swapped atomically; a published path is never modified.
+    std::shared_ptr<const std::vector<Node>> front;
+    std::atomic<std::uint64_t> version;
+
+    std::atomic<bool> running;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::thread worker;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include "IPriorityQueue.h"
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+// Open list for whole-number keys (DStarLite's integer cost mode). Both key parts are packed
+// into one uint64, k1 in the high half, so comparisons are a single integer compare. Nodes
+// are bucketed by k1 and a cursor tracks the lowest non-empty bucket; within a bucket a small
+// heap orders by k2. remove() and update() leave stale entries behind that are dropped when
+// they reach the top, so every operation is O(1) apart from the short in-bucket heaps.
+class BucketQueue : public IPriorityQueue {
+public:
+    BucketQueue();
+    explicit BucketQueue(std::pmr::memory_resource* resource);
+
+    // Throws unless both parts are whole numbers in [0, 2^32).
+    static std::uint64_t pack(const Key& key);
+    static Key unpack(std::uint64_t packed);
+
+    int count() const override;
+    bool isEmpty() const override;
+    const Node& top() const override;
+    const Key& topKey() const override;
+    bool contains(const Node& node) const override;
+    std::vector<Node> nodes() const override;
+    void insert(const Node& node, const Key& key) override;
+    Node pop() override;
+    void remove(const Node& node) override;
+    void update(const Node& node, const Key& newKey) override;
+    void reset() override;
+private:
+    struct Entry {
+        std::uint64_t key;
+        Node node;
+    };
+
+    void push(std::uint64_t key, const Node& node);
+    void settle();
+    bool live(const Entry& entry) const;
+private:
+    std::pmr::vector<std::pmr::vector<Entry>> buckets; // buckets[i] holds k1 == base + i
+    std::uint64_t base;
+    std::size_t cursor; // no live entry below this bucket
+    std::pmr::unordered_map<Node, std::uint64_t> nodeToKey;
+    Key currentKey;     // unpacked key of top()
+};
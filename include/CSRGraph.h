@@ -0,0 +1,70 @@
+#pragma once
+#include "IGraph.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Directed graph in compressed-sparse-row form for road networks and roadmaps.
+// Node ids are dense integers 0..nodeCount-1, carried in Node::row (col is always 0).
+// Out-edges of u occupy [offsets[u], offsets[u+1]) of the target/cost arrays, sorted by
+// target so edge lookups are a binary search. The reverse adjacency stores forward edge
+// indices, so a cost change is a single O(1) write. The IGraph calls still take Nodes and
+// return neighbour vectors; what the CSR layout saves is the hashing and per-node
+// allocations behind them.
+class CSRGraph : public IGraph {
+public:
+    struct Edge {
+        int from;
+        int to;
+        double cost;
+    };
+
+    CSRGraph() = default;
+    CSRGraph(int nodeCount, const std::vector<Edge>& edges);
+
+    // Native binary format ("CSRG"), host byte order.
+    static CSRGraph loadBinary(const std::string& path);
+    void saveBinary(const std::string& path) const;
+
+    // 9th DIMACS challenge files: "a u v w" arcs in .gr, "v id x y" coordinates in .co (1-based ids).
+    static CSRGraph loadDimacs(const std::string& grPath);
+    void loadDimacsCoordinates(const std::string& coPath);
+
+    // Enables the Euclidean heuristic; scale converts coordinate distance to cost units
+    // and must not overestimate any edge.
+    void setCoordinates(std::vector<double> xs, std::vector<double> ys, double scale = 1.0);
+    void setHeuristicScale(double scale);
+
+    static Node node(int id) { return Node(id, 0); }
+
+    int nodeCount() const;
+    std::int64_t edgeCount() const;
+
+    std::int64_t findEdge(int from, int to) const; // cheapest from->to edge, -1 if none
+    void setEdgeCost(std::int64_t edge, double cost); // INF closes the edge
+    double edgeCost(std::int64_t edge) const;
+    int edgeSource(std::int64_t edge) const;
+    int edgeTarget(std::int64_t edge) const;
+
+    void setWalkable(const Node& node, bool walkable) override;
+    bool isWalkable(const Node& node) const override;
+    std::vector<Node> getNeighbors(const Node& node) const override;
+    std::vector<Node> getPredecessors(const Node& node) const override;
+    double getEdgeCost(const Node& node1, const Node& node2) const override;
+    double getEuclideanDistance(const Node& node1, const Node& node2) const override;
+private:
+    void sortRows();
+    void buildReverse();
+    bool contains(int id) const;
+private:
+    std::vector<std::int64_t> offsets;    // nodeCount + 1
+    std::vector<std::int32_t> targets;    // per forward edge
+    std::vector<double> costs;            // per forward edge
+    std::vector<std::int64_t> inOffsets;  // nodeCount + 1
+    std::vector<std::int64_t> inEdges;    // forward edge index of each in-edge
+    std::vector<std::int32_t> inSources;  // source node of each in-edge
+    std::vector<char> open;               // per node walkable flag
+    std::vector<double> xs;
+    std::vector<double> ys;
+    double heuristicScale = 1.0;
+};
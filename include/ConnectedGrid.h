@@ -0,0 +1,159 @@
+#pragma once
+#include "IGraph.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+// Grid maps whose connectivity and heuristic are fixed at compile time. Neighbour loops are
+// unrolled over constexpr move tables and the heuristics avoid std::sqrt entirely.
+//   Grid4  : 4-connected,  Manhattan
+//   Grid8  : 8-connected,  octile
+//   Grid16 : 16-connected (adds knight moves), sqrt-free lower bound on Euclidean
+
+struct GridMove {
+    int dr;
+    int dc;
+    double cost;
+};
+
+namespace grid_detail {
+    inline constexpr double SQRT2 = 1.4142135623730951;
+    inline constexpr double SQRT5 = 2.23606797749979;
+    inline constexpr double INV_SQRT2 = 0.7071067811865476;
+}
+
+template<int Connectivity>
+struct GridMoves;
+
+template<>
+struct GridMoves<4> {
+    inline static constexpr std::array<GridMove, 4> moves = {{
+        {-1, 0, 1.0}, {0, -1, 1.0}, {0, 1, 1.0}, {1, 0, 1.0}
+    }};
+};
+
+template<>
+struct GridMoves<8> {
+    inline static constexpr std::array<GridMove, 8> moves = {{
+        {-1, -1, grid_detail::SQRT2}, {-1, 0, 1.0}, {-1, 1, grid_detail::SQRT2},
+        {0, -1, 1.0},                               {0, 1, 1.0},
+        {1, -1, grid_detail::SQRT2},  {1, 0, 1.0},  {1, 1, grid_detail::SQRT2}
+    }};
+};
+
+template<>
+struct GridMoves<16> {
+    inline static constexpr std::array<GridMove, 16> moves = {{
+        {-2, -1, grid_detail::SQRT5}, {-2, 1, grid_detail::SQRT5},
+        {-1, -2, grid_detail::SQRT5}, {-1, -1, grid_detail::SQRT2}, {-1, 0, 1.0}, {-1, 1, grid_detail::SQRT2}, {-1, 2, grid_detail::SQRT5},
+        {0, -1, 1.0},                                                             {0, 1, 1.0},
+        {1, -2, grid_detail::SQRT5},  {1, -1, grid_detail::SQRT2},  {1, 0, 1.0},  {1, 1, grid_detail::SQRT2},  {1, 2, grid_detail::SQRT5},
+        {2, -1, grid_detail::SQRT5},  {2, 1, grid_detail::SQRT5}
+    }};
+};
+
+// Heuristics take absolute row/column offsets. `admissibleFor` lists the connectivities
+// whose shortest paths they never overestimate.
+struct ManhattanMetric {
+    static constexpr bool admissibleFor(int connectivity) { return connectivity == 4; }
+    static double distance(int dr, int dc) { return dr + dc; }
+};
+
+struct OctileMetric {
+    static constexpr bool admissibleFor(int connectivity) { return connectivity == 4 || connectivity == 8; }
+    static double distance(int dr, int dc) { 
+        return std::max(dr, dc) + (grid_detail::SQRT2 - 1.0) * std::min(dr, dc); 
+    }
+};
+
+// max(|d|inf, |d|1 / sqrt2) never exceeds the Euclidean norm and is within 8% of it.
+struct SqrtFreeEuclideanMetric {
+    static constexpr bool admissibleFor(int) { return true; }
+    static double distance(int dr, int dc) { 
+        return std::max<double>(std::max(dr, dc), (dr + dc) * grid_detail::INV_SQRT2); 
+    }
+};
+
+template<int Connectivity, typename Metric>
+class ConnectedGrid : public IGraph {
+    static_assert(Metric::admissibleFor(Connectivity), "Heuristic overestimates on this connectivity");
+public:
+    ConnectedGrid(int rows, int cols) : walkable(rows * cols, 1), rows(rows), cols(cols) {}
+
+    void setWalkable(const Node& node, bool walkable) override {
+        if (!inBounds(node.row, node.col)) return;
+        this->walkable[node.row * cols + node.col] = walkable;
+    }
+
+    bool isWalkable(const Node& node) const override {
+        return inBounds(node.row, node.col) && walkable[node.row * cols + node.col];
+    }
+
+    std::vector<Node> getNeighbors(const Node& node) const override {
+        std::vector<Node> neighbors;
+        neighbors.reserve(Connectivity);
+
+        forEachMove([&](const GridMove& move) {
+            int r = node.row + move.dr;
+            int c = node.col + move.dc;
+
+            if (inBounds(r, c) && walkable[r * cols + c]) 
+                neighbors.push_back(Node(r, c, true));
+        });
+
+        return neighbors;
+    }
+
+    double getEdgeCost(const Node& node1, const Node& node2) const override {
+        if (node1 == node2) return 0.0;
+        if (!isWalkable(node1) || !isWalkable(node2)) return INF_COST;
+
+        int dr = node2.row - node1.row;
+        int dc = node2.col - node1.col;
+        double cost = INF_COST;
+
+        forEachMove([&](const GridMove& move) {
+            if (move.dr == dr && move.dc == dc) cost = move.cost;
+        });
+
+        return cost;
+    }
+
+    double getEuclideanDistance(const Node& node1, const Node& node2) const override {
+        int dr = node1.row - node2.row;
+        int dc = node1.col - node2.col;
+        return std::sqrt(dr * dr + dc * dc);
+    }
+
+    double getHeuristic(const Node& node1, const Node& node2) const override {
+        return Metric::distance(std::abs(node1.row - node2.row), std::abs(node1.col - node2.col));
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+private:
+    template<typename F>
+    static void forEachMove(F&& f) {
+        forEachMove(f, std::make_index_sequence<Connectivity>());
+    }
+
+    template<typename F, std::size_t... I>
+    static void forEachMove(F& f, std::index_sequence<I...>) {
+        (f(GridMoves<Connectivity>::moves[I]), ...);
+    }
+
+    bool inBounds(int r, int c) const {
+        return 0 <= r && r < rows && 0 <= c && c < cols;
+    }
+private:
+    std::vector<char> walkable; // row-major
+    int rows;
+    int cols;
+};
+
+using Grid4 = ConnectedGrid<4, ManhattanMetric>;
+using Grid8 = ConnectedGrid<8, OctileMetric>;
+using Grid16 = ConnectedGrid<16, SqrtFreeEuclideanMetric>;
@@ -1,31 +1,119 @@
 #pragma once
 #include "IGraph.h"
+#include "BucketQueue.h"
+#include "IHeuristic.h"
 #include "MinHeapMap.h" 
+#include "SearchArena.h"
 #include <unordered_map>
 
+struct SearchStats {
+    long long expansions = 0; // nodes popped and expanded by computeShortestPath()
+    long long evictions = 0;  // nodes dropped to stay within the memory budget
+
+    // Change-impact filter, see notifyEnvironmentChanges().
+    long long replans = 0;           // notifyEnvironmentChanges() calls
+    long long replansSkipped = 0;    // of those, answered from the cached path
+    long long irrelevantChanges = 0; // left every node consistent
+    long long frontierChanges = 0;   // queued nodes the current search would not reach
+    long long pathChanges = 0;       // touched the path or queued a node below the start key
+};
+
+enum class CostMode {
+    Floating, // any non-negative costs, binary-heap open list
+    Integer   // whole-number costs, exact keys packed into a bucket queue
+};
+
 // You must call findPath() before calling notifyEnvironmentChanges()
 class DStarLite {
 public:
-    DStarLite(const IGraph& graph);
+    DStarLite(const IGraph& graph, SearchArena* arena = nullptr); // arena must outlive the planner
     std::vector<Node> findPath(const Node& start, const Node& goal);
+
+    // Changes to cells with no search state are dropped in O(1), and predecessors are only
+    // revisited when the changed node has a finite g. If no change reaches the last path and
+    // every queued key stays at or above the start's, the search would expand nothing, so the
+    // rest of the last path is returned without searching or rebuilding it.
     std::vector<Node> notifyEnvironmentChanges(const Node& agentNode, const std::vector<Node>& updatedNodes);
+
+    // Focused replanning: notifyEnvironmentChanges() only repairs nodes within `radius`
+    // (heuristic distance) of the agent. Inconsistent nodes outside the window are deferred,
+    // so the returned path is optimal inside the window given the g-values at its border, and
+    // its cost is bounded by the optimum plus `radius`. If that path would run through a
+    // deferred node, fail to reach the goal or break the bound, the deferred repair is
+    // finished before returning.
+    void setFocusRadius(double radius);
+    std::vector<Node> resumeDeferred(); // finishes the deferred far-field repair
+    int deferredCount() const;
+
+    // Memory-bounded mode: once more than `maxNodes` nodes carry search state, the state farthest
+    // from the agent is evicted after each search, keeping the path and everything it depends
+    // on. Evicted regions are re-explored on demand, so paths stay optimal. 0 means unbounded.
+    // A budget smaller than the path and the queued nodes need is exceeded by that much.
+    void setMemoryBudget(std::size_t maxNodes);
+    std::size_t stateSize() const; // nodes with a g or rhs entry, or both
+
+    // Integer mode: the graph must report whole-number edge costs (e.g. Grid::setCostScale(10, 14)).
+    // Heuristic values are rounded down, which keeps them admissible and consistent, so every
+    // g, rhs and key is a whole number, summed exactly, and compared without tolerance.
+    // Call before findPath().
+    void setCostMode(CostMode mode);
+
+    void setHeuristic(const IHeuristic* heuristic); // nullptr restores the graph's own heuristic; call before findPath()
+
+    // Re-keys every queued node after the heuristic's values changed under a running search,
+    // e.g. LandmarkHeuristic refreshing its tables. Call before notifyEnvironmentChanges().
+    void heuristicChanged();
+    const SearchStats& stats() const;
+    void resetStats();
 private:
-    inline static constexpr double EPSILON = 1e-6; // tolerance for floating-point comparisons
+    inline static constexpr double EPSILON = 1e-6; // tolerance for floating-point comparisons; keys are rounded to multiples of it
 
     const IGraph& graph;
-    MinHeapMap heap;
+    GraphHeuristic graphHeuristic;
+    const IHeuristic* heuristic;
+    SearchStats searchStats;
+    SearchArena* arena; // optional; reset at the start of every findPath()
+    CostMode costMode;
+    MinHeapMap heapQueue;
+    MinHeapMap deferredHeap;     // inconsistent nodes outside the focus window
+    BucketQueue bucketQueue;     // integer mode counterparts
+    BucketQueue deferredBuckets;
+
+    double focusRadius;
+    bool focusing;
 
     Node start;
     Node goal;
     Node last;
     double km;
 
-    std::unordered_map<Node, double> gCosts;
-    std::unordered_map<Node, double> rhsCosts;
+    std::pmr::unordered_map<Node, double> gCosts;
+    std::pmr::unordered_map<Node, double> rhsCosts;
+
+    std::size_t memoryBudget; // 0 = unbounded
+    std::size_t stateNodes;   // nodes with a g or rhs entry, see setG()
+
+    std::vector<Node> cachedPath; // last path returned, empty if none
+    std::pmr::unordered_map<Node, std::size_t> cachedPathIndex;
 
+    void resetSearchState();
+    std::pmr::memory_resource* resource() const;
+    IPriorityQueue& openList();
+    IPriorityQueue& deferredList();
+    double estimate(const Node& from, const Node& to) const;
     Key calculateKey(const Node& node);
+    double quantize(double value) const;
     void updateNode(const Node& node);
     void computeShortestPath();
+    bool inFocus(const Node& node) const;
+    void requeueDeferred();
+    bool withinFocusBound(const std::vector<Node>& path);
     double computeRhs(const Node& node);
+    void setG(const Node& node, double g);
+    void setRhs(const Node& node, double rhs);
+    bool bestSuccessor(const Node& node, Node& successor);
+    void enforceMemoryBudget(const std::vector<Node>& path);
+    std::size_t evictColdState(const std::vector<Node>& path, std::size_t target);
     std::vector<Node> buildPath();
+    std::vector<Node> finishSearch(); // builds, caches and returns the path
 };
@@ -0,0 +1,68 @@
+#pragma once
+#include "Grid.h"
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Shared cost-to-goal field for many agents heading to one goal. The field is a dense LPA*
+// search rooted at the goal with a zero heuristic, so unlike DStarLite it settles every
+// reachable cell instead of stopping at one start. Each cell also keeps its best successor as
+// a 3-bit index into the 8 grid moves. After walkability changes, only cells whose cost moved
+// are re-expanded, and only their neighbourhoods get their directions recomputed. Agents then
+// step in O(1) with nextStep(), or read costs() and directions() directly. Reads are safe from
+// several threads as long as no update() or setGoal() runs concurrently.
+class FlowField {
+public:
+    inline static constexpr int DIRECTION_BITS = 3;
+    inline static constexpr int DIRECTIONS_PER_WORD = 64 / DIRECTION_BITS; // 21, top bit unused
+
+    FlowField(const Grid& grid, const Node& goal);
+
+    // Rebuilds the field from scratch for a new goal.
+    void setGoal(const Node& goal);
+
+    // Repairs the field after the given cells changed walkability on the grid. Like
+    // DStarLite::notifyEnvironmentChanges(), the grid must already be updated.
+    void update(const std::vector<Node>& updatedNodes);
+
+    // The neighbour to move to next; the cell itself at the goal, for unreachable cells and
+    // outside the grid.
+    Node nextStep(const Node& node) const;
+    double cost(const Node& node) const; // INF_COST when unreachable or outside the grid
+
+    // Zero-copy views, row-major. Cell i's direction is bits [3 * (i % 21), 3 * (i % 21) + 3) of
+    // word i / 21, indexing {NW, N, NE, W, E, SW, S, SE}; it is meaningless where the cost is
+    // INF_COST and at the goal.
+    const std::vector<double>& costs() const;
+    const std::vector<std::uint64_t>& directions() const;
+
+    const Node& getGoal() const;
+    long long expansions() const; // cells expanded since construction
+private:
+    inline static constexpr double EPSILON = 1e-6; // same tolerance as DStarLite
+
+    void computeField();
+    void updateCell(int cell);
+    void refreshDirections();
+    void setDirection(int cell);
+    void touch(int cell);
+    double edgeCost(int cell, int direction, int& neighbor) const;
+private:
+    const Grid& grid;
+    Node goal;
+    int goalCell;
+    int rows;
+    int cols;
+    long long expanded = 0;
+
+    std::vector<double> g;
+    std::vector<double> rhs;
+    std::vector<std::uint64_t> packed;
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    std::vector<int> touched;  // cells whose cost or edges changed since the last refresh
+    std::vector<char> isTouched;
+};
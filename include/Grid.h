@@ -1,5 +1,6 @@
 #pragma once
 #include "IGraph.h"
+#include <array>
 #include <vector>
 #include <unordered_map>
 #include <cmath>
@@ -13,12 +14,46 @@ public:
     std::vector<Node> getNeighbors(const Node& node) const override;
     double getEdgeCost(const Node& node1, const Node& node2) const override;
     double getEuclideanDistance(const Node& node1, const Node& node2) const override;
+    double getHeuristic(const Node& node1, const Node& node2) const override; // octile distance
+
+    // Edge costs for straight and diagonal moves, 1 and sqrt(2) by default. Whole numbers such
+    // as (10, 14) suit DStarLite's integer cost mode. Requires 0 < straight <= diagonal <= 2 * straight
+    // so the octile heuristic stays admissible. Euclidean distance stays in cells.
+    void setCostScale(double straight, double diagonal);
+
+    // Connectivity index: walkable cells are labelled per TILE x TILE tile, each tile caches
+    // which of its labels touch which labels of the tiles to its right and below, and a
+    // union-find over the labels joins them. setWalkable() only marks its tile dirty and, for
+    // a new wall, checks in O(1) whether the wall could split a component. Whoever edits the
+    // grid calls updateConnectivity() once a batch of edits is in: it relabels and relinks the
+    // dirty tiles and folds them into the union-find; only a batch that may have split a
+    // component rebuilds it. The queries are const and never write, so any number of readers
+    // may share the grid between updates. While edits are pending, isReachable() answers true
+    // and componentOf() throws.
+    void updateConnectivity() override;
+    bool isReachable(const Node& from, const Node& to) const override;
+    int componentOf(const Node& node) const; // -1 for blocked or out-of-bounds cells
+
+    int getRows() const;
+    int getCols() const;
 private:
-    const std::vector<std::pair<int, int>> directions = {
+    void labelTile(int tile);
+    void remapTile(int tile, const std::vector<int>& oldLabels, const std::vector<int>& oldIds);
+    void linkTile(int tile);
+    void addLink(int tile, int row1, int col1, int row2, int col2);
+    void rebuildComponents();
+    bool maySplit(const Node& node) const;
+    int findComponent(int id) const;
+    void unite(int a, int b);
+private:
+    inline static constexpr int TILE = 32;
+    inline static constexpr int BLOCKED = -1;
+
+    inline static constexpr std::array<std::pair<int, int>, 8> directions = {{
         {-1, -1}, {-1, 0}, {-1, 1},
         {0, -1},           {0, 1},
         {1, -1},  {1, 0},  {1, 1}
-    };
+    }};
 
     inline static constexpr double DIAGONAL_COST = std::sqrt(2);
     inline static constexpr double STRAIGHT_COST = 1.0;
@@ -26,4 +61,26 @@ private:
     std::vector<std::vector<Node>> grid;
     int rows;
     int cols;
+    double straightCost;
+    double diagonalCost;
+
+    int tileRows;
+    int tileCols;
+    std::vector<int> localLabel;             // per cell: component inside its tile, BLOCKED if unwalkable
+    std::vector<char> edited;                // per cell: changed since the last update
+    std::vector<int> tileComponents;         // per tile: number of local components
+    std::vector<std::vector<int>> labelIds;  // per tile: union-find element of each local component
+    std::vector<int> parent;                 // union-find over elements, union by size
+    std::vector<int> componentSize;
+    std::vector<char> tileDirty;
+
+    struct Link {
+        int label;      // local label in the owning tile
+        int tile;       // neighbouring tile
+        int otherLabel; // local label there
+    };
+    std::vector<std::vector<Link>> tileLinks; // per tile: links to its right and lower neighbours
+    std::vector<char> linksDirty;
+    bool componentsDirty; // edits since the last update
+    bool splitPending;    // one of them may have split a component
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <iostream>
@@ -7,21 +8,46 @@
 struct Node {
     int row; 
     int col;
+    int layer; // 0 on 2D maps
     bool walkable;
 
-    Node() : row(0), col(0), walkable(true) {}
-    Node(int r, int c, bool w = true) : row(r), col(c), walkable(w) {}
+    Node() : row(0), col(0), layer(0), walkable(true) {}
+    Node(int r, int c, bool w = true) : row(r), col(c), layer(0), walkable(w) {}
+    Node(int r, int c, int l, bool w) : row(r), col(c), layer(l), walkable(w) {}
 
     bool operator==(const Node& other) const {
-        return row == other.row && col == other.col;
+        return row == other.row && col == other.col && layer == other.layer;
     }
 
     bool operator!=(const Node& other) const {
         return !(*this == other);
     }
 
+    // Both coordinates packed into one 64-bit value, row in the high half.
+    std::uint64_t key() const {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(row)) << 32) | static_cast<std::uint32_t>(col);
+    }
+
+    // key() with the layer folded in; equal to key() on 2D maps, so their hashes are unchanged.
+    std::uint64_t spatialKey() const {
+        return key() ^ (static_cast<std::uint64_t>(static_cast<std::uint32_t>(layer)) * 0x9e3779b97f4a7c15ULL);
+    }
+
+    // splitmix64 finalizer: every key bit affects every hash bit, so neighbouring
+    // grid cells land in unrelated buckets even with power-of-two tables.
+    static std::uint64_t mixKey(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const Node& node) {
-        os << "(" << node.row << ", " << node.col << ")";
+        os << "(" << node.row << ", " << node.col;
+        if (node.layer != 0) os << ", " << node.layer;
+        os << ")";
         return os;
     }
 };
@@ -30,7 +56,7 @@ namespace std {
     template<>
     struct hash<Node> {
         std::size_t operator()(const Node& n) const {
-            return std::hash<int>{}(n.row) ^ (std::hash<int>{}(n.col) << 1); // could be improved
+            return static_cast<std::size_t>(Node::mixKey(n.spatialKey()));
         }
     };
 }
@@ -44,4 +70,26 @@ public:
     virtual std::vector<Node> getNeighbors(const Node& n) const = 0;
     virtual double getEdgeCost(const Node& node1, const Node& node2) const = 0;
     virtual double getEuclideanDistance(const Node& node1, const Node& node2) const = 0;
+
+    // Nodes with an edge into n. Undirected graphs can rely on the default.
+    virtual std::vector<Node> getPredecessors(const Node& n) const {
+        return getNeighbors(n);
+    }
+
+    // Planner heuristic; graphs override it with a tighter or cheaper admissible metric.
+    virtual double getHeuristic(const Node& node1, const Node& node2) const {
+        return getEuclideanDistance(node1, node2);
+    }
+
+    // False only when no path from `from` to `to` can exist. Graphs without a connectivity
+    // index answer true and let the planner find out.
+    virtual bool isReachable(const Node& from, const Node& to) const {
+        (void)from;
+        (void)to;
+        return true;
+    }
+
+    // Brings the connectivity index up to date after a batch of setWalkable() calls. Called by
+    // the code that edits the graph, never by readers.
+    virtual void updateConnectivity() {}
 };
@@ -0,0 +1,34 @@
+#pragma once
+#include "IGraph.h"
+
+// Cost estimate between two nodes. Must be admissible and consistent for D* Lite
+// to return optimal paths.
+class IHeuristic {
+public:
+    virtual ~IHeuristic() = default;
+    virtual double estimate(const Node& from, const Node& to) const = 0;
+};
+
+// Default heuristic: whatever the graph reports through IGraph::getHeuristic().
+class GraphHeuristic : public IHeuristic {
+public:
+    GraphHeuristic(const IGraph& graph) : graph(graph) {}
+
+    double estimate(const Node& from, const Node& to) const override {
+        return graph.getHeuristic(from, to);
+    }
+private:
+    const IGraph& graph;
+};
+
+// The graph's straight-line distance.
+class EuclideanHeuristic : public IHeuristic {
+public:
+    EuclideanHeuristic(const IGraph& graph) : graph(graph) {}
+
+    double estimate(const Node& from, const Node& to) const override {
+        return graph.getEuclideanDistance(from, to);
+    }
+private:
+    const IGraph& graph;
+};
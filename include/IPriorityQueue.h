@@ -0,0 +1,37 @@
+#pragma once
+#include "IGraph.h"
+#include <vector>
+
+struct Key {   // Sorted lexicographically.
+    double k1; // min(g, rhs) + h + km
+    double k2; // min(g, rhs)
+
+    Key() : k1(0.0), k2(0.0) {}
+
+    Key(double k1, double k2) : k1(k1), k2(k2) {}
+
+    bool operator<(const Key& other) const {
+        return k1 < other.k1 || (k1 == other.k1 && k2 < other.k2);
+    }
+
+    bool operator>(const Key& other) const {
+        return k1 > other.k1 || (k1 == other.k1 && k2 > other.k2);
+    }
+};
+
+// Open list of D* Lite: every node appears at most once, keyed by its Key.
+class IPriorityQueue {
+public:
+    virtual ~IPriorityQueue() = default;
+    virtual int count() const = 0;
+    virtual bool isEmpty() const = 0;
+    virtual const Node& top() const = 0;
+    virtual const Key& topKey() const = 0;
+    virtual bool contains(const Node& node) const = 0;
+    virtual std::vector<Node> nodes() const = 0; // queued nodes, in no particular order
+    virtual void insert(const Node& node, const Key& key) = 0;
+    virtual Node pop() = 0;
+    virtual void remove(const Node& node) = 0;
+    virtual void update(const Node& node, const Key& newKey) = 0;
+    virtual void reset() = 0;
+};
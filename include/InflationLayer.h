@@ -0,0 +1,57 @@
+#pragma once
+#include "Grid.h"
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Configuration-space layer for round robots on a Grid. The layer owns the raw obstacle map
+// and keeps a dynamic brushfire distance map (Lau et al., "Improved updating of Euclidean
+// distance maps and Voronoi diagrams"): every cell stores its nearest obstacle and the
+// squared distance to it. After an obstacle change, only cells whose nearest obstacle changed
+// are revisited. Cells closer than the robot radius are set unwalkable on the grid.
+class InflationLayer {
+public:
+    // Unwalkable cells of the grid become the initial obstacles; radius is in cells.
+    InflationLayer(Grid& grid, double robotRadius);
+
+    // Applies raw obstacle changes (walkable == false adds an obstacle) and returns exactly the
+    // cells whose inflated walkability flipped. The grid and its connectivity index are already
+    // updated, so the result can be passed straight to DStarLite::notifyEnvironmentChanges().
+    std::vector<Node> update(const std::vector<Node>& obstacleChanges);
+
+    bool isObstacle(const Node& node) const;
+    double clearance(const Node& node) const; // INF_COST beyond the propagation limit
+    double getRadius() const;
+private:
+    inline static constexpr int NO_OBSTACLE = -1;
+    inline static constexpr std::int64_t FAR = INT64_MAX;
+
+    void setObstacle(int cell);
+    void removeObstacle(int cell);
+    void propagate();
+    void raise(int cell);
+    void lower(int cell);
+    void touch(int cell);
+    bool inflated(int cell) const;
+    std::int64_t squaredDistance(int a, int b) const;
+private:
+    Grid& grid;
+    double radius;
+    std::int64_t radiusSquared;  // cells at or below are blocked
+    std::int64_t limitSquared;   // brushfire stops beyond this
+
+    int rows;
+    int cols;
+    std::vector<char> occupied;             // raw obstacles
+    std::vector<int> nearest;               // nearest obstacle cell or NO_OBSTACLE
+    std::vector<std::int64_t> distSquared;  // to nearest, FAR when none
+    std::vector<char> toRaise;
+    std::vector<char> blocked;              // inflated state last pushed to the grid
+
+    using Entry = std::pair<std::int64_t, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    std::vector<int> touched;               // cells whose distance changed this update
+    std::vector<char> isTouched;
+};
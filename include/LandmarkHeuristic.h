@@ -0,0 +1,48 @@
+#pragma once
+#include "IHeuristic.h"
+#include "Grid.h"
+#include <cstdint>
+#include <vector>
+
+// ALT heuristic (A*, landmarks, triangle inequality) for Grid maps:
+// h(a, b) = max over landmarks L of |d(L, a) - d(L, b)|, never below the grid's own heuristic.
+// Distances from every landmark are precomputed with Dijkstra, one thread per landmark,
+// and stored as uint16 steps of a per-landmark scale.
+class LandmarkHeuristic : public IHeuristic {
+public:
+    LandmarkHeuristic(const Grid& grid, const std::vector<Node>& landmarks);
+    LandmarkHeuristic(const Grid& grid, int landmarkCount);
+
+    double estimate(const Node& from, const Node& to) const override;
+
+    // Call after changing the grid. Returns true if tables were recomputed; a running planner
+    // then needs DStarLite::heuristicChanged() before its notifyEnvironmentChanges().
+    bool notifyEnvironmentChanges(const std::vector<Node>& updatedNodes);
+    void recompute();
+
+    const std::vector<Node>& getLandmarks() const;
+    std::size_t memoryBytes() const;
+
+    // Spreads `count` landmarks over the walkable cells by farthest-point sampling.
+    static std::vector<Node> selectLandmarks(const Grid& grid, int count);
+private:
+    inline static constexpr std::uint16_t UNREACHABLE = 0xFFFF;
+    inline static constexpr std::uint16_t MAX_STEPS = 0xFFFE;
+
+    struct Table {
+        std::vector<std::uint16_t> steps; // floor(d / scale), row-major
+        std::vector<std::uint64_t> walkable; // bitmask of the cells walkable when computed
+        double scale;                     // cost of one step
+        double stepWeight;                // scale shrunk so rounding keeps h consistent
+    };
+
+    void computeTable(int landmark);
+    void recomputeTables(const std::vector<int>& landmarkIndices);
+    bool shortensPaths(const Table& table, const Node& node) const;
+    static bool wasWalkable(const Table& table, int cell);
+    int index(const Node& node) const;
+private:
+    const Grid& grid;
+    std::vector<Node> landmarks;
+    std::vector<Table> tables;
+};
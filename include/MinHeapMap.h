@@ -1,25 +1,10 @@
 #pragma once
 #include "Grid.h"
+#include "IPriorityQueue.h"
 #include <stdexcept>
 #include <vector>
 #include <unordered_map>
-
-struct Key {   // Sorted lexicographically.
-    double k1; // min(g, rhs) + h + km
-    double k2; // min(g, rhs)
-
-    Key() : k1(0.0), k2(0.0) {}
-
-    Key(double k1, double k2) : k1(k1), k2(k2) {}
-
-    bool operator<(const Key& other) const {
-        return k1 < other.k1 || (k1 == other.k1 && k2 < other.k2);
-    }
-
-    bool operator>(const Key& other) const {
-        return k1 > other.k1 || (k1 == other.k1 && k2 > other.k2);
-    }
-};
+#include <memory_resource>
 
 struct HeapNode {
     Node node;
@@ -29,21 +14,23 @@ struct HeapNode {
 };
 
 // Tailored for D* Lite
-class MinHeapMap {
+class MinHeapMap : public IPriorityQueue {
 public:
     MinHeapMap();
+    explicit MinHeapMap(std::pmr::memory_resource* resource);
     MinHeapMap(const std::vector<HeapNode>& nodes);
 
-    int count() const;
-    bool isEmpty() const;
-    const Node& top() const;
-    const Key& topKey() const;
-    bool contains(const Node& node) const;
-    void insert(const Node& node, const Key& key);
-    Node pop();
-    void remove(const Node& node);
-    void update(const Node& node, const Key& newKey);
-    void reset();
+    int count() const override;
+    bool isEmpty() const override;
+    const Node& top() const override;
+    const Key& topKey() const override;
+    bool contains(const Node& node) const override;
+    std::vector<Node> nodes() const override; // queued nodes, in heap order
+    void insert(const Node& node, const Key& key) override;
+    Node pop() override;
+    void remove(const Node& node) override;
+    void update(const Node& node, const Key& newKey) override;
+    void reset() override;
 private:
     int left(int i) const;
     int right(int i) const;
@@ -52,6 +39,6 @@ private:
     void siftDown(int i);
     void swap(int i, int j);
 private:
-    std::vector<HeapNode> heap;
-    std::unordered_map<Node, int> nodeToIndex;
+    std::pmr::vector<HeapNode> heap;
+    std::pmr::unordered_map<Node, int> nodeToIndex;
 };
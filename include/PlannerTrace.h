@@ -0,0 +1,77 @@
+#pragma once
+#include "DStarLite.h"
+#include "Grid.h"
+#include "SearchArena.h"
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Workload traces for reproducing planner performance outside the robot. A trace ("DSTR",
+// host byte order) holds the initial Grid and then every walkability edit and planner call
+// in the order they happened; nodes are stored as (row, col, walkable).
+
+struct TraceEvent {
+    enum class Type : std::uint8_t {
+        SetWalkable = 1, // node: the cell, with its new walkable flag
+        FindPath = 2,    // node: start, goal: goal
+        Notify = 3       // node: agent, changes: the updated nodes
+    };
+
+    Type type;
+    Node node;
+    Node goal;
+    std::vector<Node> changes;
+};
+
+struct PlannerTrace {
+    int rows = 0;
+    int cols = 0;
+    std::vector<char> walkable; // initial grid, row-major
+    std::vector<TraceEvent> events;
+
+    static PlannerTrace load(const std::string& path);
+};
+
+// Drop-in front for a Grid and its planner: every call is forwarded and appended to the trace
+// file. The grid's current state is written as the initial state on construction. Planner
+// calls bring the grid's connectivity index up to date first, as the replay does.
+class TraceRecorder {
+public:
+    TraceRecorder(const std::string& path, Grid& grid, DStarLite& planner);
+
+    void setWalkable(const Node& node, bool walkable);
+    std::vector<Node> findPath(const Node& start, const Node& goal);
+    std::vector<Node> notifyEnvironmentChanges(const Node& agentNode, const std::vector<Node>& updatedNodes);
+    void flush();
+private:
+    void writeNode(const Node& node);
+private:
+    std::ofstream out;
+    Grid& grid;
+    DStarLite& planner;
+};
+
+struct ReplayCall {
+    TraceEvent::Type type;
+    double micros;          // wall time of the planner call
+    long long expansions;   // expansions during the call
+    std::size_t stateSize;  // nodes with search state afterwards
+    std::size_t arenaBytes; // arena in use afterwards, 0 without an arena
+    std::size_t pathLength;
+};
+
+// Re-executes a trace on a fresh Grid and DStarLite. `configure` runs once before the first
+// event and selects the variant under test (cost scale and mode, heuristic, focus, budget);
+// the optional arena is handed to the planner. Edits are applied in recorded order, so every
+// configuration sees the same workload.
+class TraceReplayer {
+public:
+    explicit TraceReplayer(const PlannerTrace& trace); // trace must outlive the replayer
+
+    std::vector<ReplayCall> run(const std::function<void(Grid&, DStarLite&)>& configure = nullptr,
+                                SearchArena* arena = nullptr) const;
+private:
+    const PlannerTrace& trace;
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+// Memory resource for per-search planner state. Freed blocks are recycled: small ones by
+// 16-byte size class, larger ones (hash bucket arrays, rehashed tables, path buffers) by
+// power-of-two class, so a long run of replans without reset() stays at its peak footprint.
+// New blocks are bump-allocated; over-aligned ones come back only with reset(). reset()
+// rewinds the arena in O(1) and keeps the peak capacity, so once warmed up a search allocates
+// nothing from upstream.
+// Not thread-safe: give every planner its own arena.
+class SearchArena : public std::pmr::memory_resource {
+public:
+    explicit SearchArena(std::size_t initialCapacity = 64 * 1024, 
+                         std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+    SearchArena(const SearchArena&) = delete;
+    SearchArena& operator=(const SearchArena&) = delete;
+    ~SearchArena() override;
+
+    void reset(); // invalidates every block handed out so far
+    std::size_t capacity() const;
+    std::size_t used() const;
+    std::size_t upstreamAllocations() const;
+
+    // Ends the lifetime of a container whose memory all lives in `arena` without running
+    // its destructor, and constructs an empty one in its place. Use right before reset().
+    template<typename Container>
+    static void abandon(Container& container, SearchArena* arena) {
+        new (&container) Container(arena);
+    }
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+private:
+    inline static constexpr std::size_t GRANULE = 16;
+    inline static constexpr std::size_t SIZE_CLASSES = 16; // small classes, up to 256 bytes
+    inline static constexpr std::size_t LARGE_CLASSES = 64; // 2^k bytes above that
+
+    struct Chunk {
+        char* data;
+        std::size_t size;
+    };
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void* bump(std::size_t bytes, std::size_t alignment);
+    void addChunk(std::size_t minBytes);
+    static int sizeClass(std::size_t bytes, std::size_t alignment);
+    static int largeClass(std::size_t bytes, std::size_t alignment);
+private:
+    std::pmr::memory_resource* upstream;
+    std::vector<Chunk> chunks;
+    std::size_t current;  // chunk being bumped
+    std::size_t offset;   // bump position inside it
+    std::size_t usedBytes;
+    std::size_t allocations;
+    FreeBlock* freeLists[SIZE_CLASSES];
+    FreeBlock* largeLists[LARGE_CLASSES];
+};
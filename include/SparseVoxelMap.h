@@ -0,0 +1,48 @@
+#pragma once
+#include "IGraph.h"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Occupancy of an unbounded voxel volume, stored as 8x8x8 bitmask bricks in a hash map.
+// Only bricks holding at least one occupied voxel exist, so empty airspace costs nothing.
+// Voxels are addressed as Node(row, col, layer).
+class SparseVoxelMap {
+public:
+    struct Point {
+        double x; // along col
+        double y; // along row
+        double z; // along layer
+    };
+
+    inline static constexpr int BRICK_BITS = 3;
+    inline static constexpr int BRICK_SIZE = 1 << BRICK_BITS;
+
+    bool isOccupied(int row, int col, int layer) const;
+    bool setOccupied(int row, int col, int layer, bool occupied); // true if the voxel changed
+
+    // Marks the voxels hit by a point cloud (voxel = floor(point / voxelSize)) as occupied and
+    // returns the ones that were free before, ready for notifyEnvironmentChanges().
+    std::vector<Node> insertPoints(const std::vector<Point>& points, double voxelSize);
+
+    // Applies a batch of walkability changes; returns the voxels whose state actually changed.
+    std::vector<Node> apply(const std::vector<Node>& voxels);
+
+    void clear();
+    std::size_t brickCount() const;
+    std::size_t occupiedCount() const;
+    std::size_t memoryBytes() const;
+private:
+    struct Brick {
+        std::array<std::uint64_t, BRICK_SIZE * BRICK_SIZE * BRICK_SIZE / 64> bits{};
+        int occupied = 0;
+    };
+
+    static std::uint64_t brickKey(int row, int col, int layer);
+    static int bitIndex(int row, int col, int layer);
+    bool setBit(Brick& brick, int bit, bool occupied);
+private:
+    std::unordered_map<std::uint64_t, Brick> bricks;
+    std::size_t occupiedVoxels = 0;
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Lock-free ring buffer for exactly one producer thread and one consumer thread.
+template<typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity) : slots(capacity + 1), head(0), tail(0) {}
+
+    bool push(T item) { // producer only, false when full
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        std::size_t next = increment(t);
+
+        if (next == head.load(std::memory_order_acquire))
+            return false;
+
+        slots[t] = std::move(item);
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) { // consumer only, false when empty
+        std::size_t h = head.load(std::memory_order_relaxed);
+
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+
+        item = std::move(slots[h]);
+        head.store(increment(h), std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { 
+        return slots.size() - 1; 
+    }
+private:
+    std::size_t increment(std::size_t i) const { 
+        return i + 1 == slots.size() ? 0 : i + 1; 
+    }
+private:
+    std::vector<T> slots; // one slot stays empty to tell full from empty
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+};
@@ -0,0 +1,204 @@
+#pragma once
+#include "IGraph.h"
+#include "SparseVoxelMap.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+// 3D voxel maps for aerial planning. Cells are Node(row, col, layer); occupancy lives in a
+// SparseVoxelMap, so free airspace takes no memory. Connectivity and heuristic are fixed at
+// compile time as in ConnectedGrid.
+//   VoxelGrid6  : faces,                   Manhattan
+//   VoxelGrid18 : faces + edges,           3D octile
+//   VoxelGrid26 : faces + edges + corners, 3D octile
+
+struct VoxelMove {
+    int dr;
+    int dc;
+    int dl;
+    double cost;
+};
+
+namespace voxel_detail {
+    inline constexpr double SQRT2 = 1.4142135623730951;
+    inline constexpr double SQRT3 = 1.7320508075688772;
+
+    // All unit offsets that change at most `axes` coordinates, costed by their length.
+    template<int Connectivity, int Axes>
+    constexpr std::array<VoxelMove, Connectivity> makeMoves() {
+        std::array<VoxelMove, Connectivity> moves{};
+        int count = 0;
+
+        for (int dr = -1; dr <= 1; dr++) {
+            for (int dc = -1; dc <= 1; dc++) {
+                for (int dl = -1; dl <= 1; dl++) {
+                    int changed = (dr != 0) + (dc != 0) + (dl != 0);
+                    if (changed == 0 || changed > Axes) continue;
+
+                    double cost = changed == 1 ? 1.0 : changed == 2 ? SQRT2 : SQRT3;
+                    moves[count++] = VoxelMove{dr, dc, dl, cost};
+                }
+            }
+        }
+
+        return moves;
+    }
+}
+
+template<int Connectivity>
+struct VoxelMoves;
+
+template<>
+struct VoxelMoves<6> {
+    inline static constexpr std::array<VoxelMove, 6> moves = voxel_detail::makeMoves<6, 1>();
+};
+
+template<>
+struct VoxelMoves<18> {
+    inline static constexpr std::array<VoxelMove, 18> moves = voxel_detail::makeMoves<18, 2>();
+};
+
+template<>
+struct VoxelMoves<26> {
+    inline static constexpr std::array<VoxelMove, 26> moves = voxel_detail::makeMoves<26, 3>();
+};
+
+// Heuristics take absolute row/column/layer offsets.
+struct VoxelManhattanMetric {
+    static constexpr bool admissibleFor(int connectivity) { return connectivity == 6; }
+    static double distance(int dr, int dc, int dl) { return dr + dc + dl; }
+};
+
+struct VoxelEuclideanMetric {
+    static constexpr bool admissibleFor(int) { return true; }
+    static double distance(int dr, int dc, int dl) { return std::sqrt(double(dr * dr + dc * dc + dl * dl)); }
+};
+
+// Exact obstacle-free distance on 26-connected voxels: corner moves, then edge moves, then faces.
+// Sparser connectivities only lengthen paths, so it is a lower bound for all of them.
+struct VoxelOctileMetric {
+    static constexpr bool admissibleFor(int) { return true; }
+    static double distance(int dr, int dc, int dl) {
+        int hi = std::max({dr, dc, dl});
+        int lo = std::min({dr, dc, dl});
+        int mid = dr + dc + dl - hi - lo;
+        return voxel_detail::SQRT3 * lo + voxel_detail::SQRT2 * (mid - lo) + (hi - mid);
+    }
+};
+
+template<int Connectivity, typename Metric>
+class VoxelGrid : public IGraph {
+    static_assert(Metric::admissibleFor(Connectivity), "Heuristic overestimates on this connectivity");
+public:
+    VoxelGrid(int rows, int cols, int layers) : rows(rows), cols(cols), layers(layers) {}
+
+    void setWalkable(const Node& node, bool walkable) override {
+        if (!inBounds(node.row, node.col, node.layer)) return;
+        occupancy.setOccupied(node.row, node.col, node.layer, !walkable);
+    }
+
+    bool isWalkable(const Node& node) const override {
+        return inBounds(node.row, node.col, node.layer) && !occupancy.isOccupied(node.row, node.col, node.layer);
+    }
+
+    std::vector<Node> getNeighbors(const Node& node) const override {
+        std::vector<Node> neighbors;
+        neighbors.reserve(Connectivity);
+
+        forEachMove([&](const VoxelMove& move) {
+            int r = node.row + move.dr;
+            int c = node.col + move.dc;
+            int l = node.layer + move.dl;
+
+            if (inBounds(r, c, l) && !occupancy.isOccupied(r, c, l))
+                neighbors.push_back(Node(r, c, l, true));
+        });
+
+        return neighbors;
+    }
+
+    double getEdgeCost(const Node& node1, const Node& node2) const override {
+        if (node1 == node2) return 0.0;
+        if (!isWalkable(node1) || !isWalkable(node2)) return INF_COST;
+
+        int dr = node2.row - node1.row;
+        int dc = node2.col - node1.col;
+        int dl = node2.layer - node1.layer;
+        double cost = INF_COST;
+
+        forEachMove([&](const VoxelMove& move) {
+            if (move.dr == dr && move.dc == dc && move.dl == dl) cost = move.cost;
+        });
+
+        return cost;
+    }
+
+    double getEuclideanDistance(const Node& node1, const Node& node2) const override {
+        return VoxelEuclideanMetric::distance(node1.row - node2.row, node1.col - node2.col, node1.layer - node2.layer);
+    }
+
+    double getHeuristic(const Node& node1, const Node& node2) const override {
+        return Metric::distance(std::abs(node1.row - node2.row), std::abs(node1.col - node2.col),
+                                std::abs(node1.layer - node2.layer));
+    }
+
+    // Batch updates: both return only the voxels whose state changed, ready for
+    // DStarLite::notifyEnvironmentChanges(). Points and voxels outside the volume are ignored.
+    std::vector<Node> insertPoints(const std::vector<SparseVoxelMap::Point>& points, double voxelSize) {
+        std::vector<SparseVoxelMap::Point> inside;
+        inside.reserve(points.size());
+
+        for (const SparseVoxelMap::Point& p : points) {
+            double r = std::floor(p.y / voxelSize);
+            double c = std::floor(p.x / voxelSize);
+            double l = std::floor(p.z / voxelSize);
+
+            if (0 <= r && r < rows && 0 <= c && c < cols && 0 <= l && l < layers)
+                inside.push_back(p);
+        }
+
+        return occupancy.insertPoints(inside, voxelSize);
+    }
+
+    std::vector<Node> applyChanges(const std::vector<Node>& voxels) {
+        std::vector<Node> inside;
+        inside.reserve(voxels.size());
+
+        for (const Node& voxel : voxels)
+            if (inBounds(voxel.row, voxel.col, voxel.layer)) inside.push_back(voxel);
+
+        return occupancy.apply(inside);
+    }
+
+    const SparseVoxelMap& getOccupancy() const { return occupancy; }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getLayers() const { return layers; }
+private:
+    template<typename F>
+    static void forEachMove(F&& f) {
+        forEachMove(f, std::make_index_sequence<Connectivity>());
+    }
+
+    template<typename F, std::size_t... I>
+    static void forEachMove(F& f, std::index_sequence<I...>) {
+        (f(VoxelMoves<Connectivity>::moves[I]), ...);
+    }
+
+    bool inBounds(int r, int c, int l) const {
+        return 0 <= r && r < rows && 0 <= c && c < cols && 0 <= l && l < layers;
+    }
+private:
+    SparseVoxelMap occupancy;
+    int rows;
+    int cols;
+    int layers;
+};
+
+using VoxelGrid6 = VoxelGrid<6, VoxelManhattanMetric>;
+using VoxelGrid18 = VoxelGrid<18, VoxelOctileMetric>;
+using VoxelGrid26 = VoxelGrid<26, VoxelOctileMetric>;
@@ -0,0 +1,118 @@
+#include "AsyncDStarLite.h"
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+AsyncDStarLite::AsyncDStarLite(IGraph& graph, std::size_t queueCapacity) 
+    : graph(graph), planner(graph), updates(queueCapacity), version(0), running(false) {
+    front = std::make_shared<const std::vector<Node>>();
+}
+
+AsyncDStarLite::~AsyncDStarLite() {
+    stop();
+}
+
+void AsyncDStarLite::setFocusRadius(double radius) {
+    if (running)
+        throw std::runtime_error("Planner already running!");
+
+    planner.setFocusRadius(radius);
+}
+
+void AsyncDStarLite::start(const Node& start, const Node& goal) {
+    if (running)
+        throw std::runtime_error("Planner already running!");
+
+    running = true;
+    worker = std::thread(&AsyncDStarLite::run, this, start, goal);
+}
+
+void AsyncDStarLite::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+        wake.notify_one();
+    }
+
+    if (worker.joinable())
+        worker.join();
+}
+
+bool AsyncDStarLite::pushUpdate(const Node& agentNode, const std::vector<Node>& updatedNodes) {
+    if (!updates.push(PlannerUpdate(agentNode, updatedNodes)))
+        return false;
+
+    // The idle planner checks the queue and goes to sleep under wakeMutex, so notifying under
+    // it cannot land between the two.
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    wake.notify_one();
+    return true;
+}
+
+std::shared_ptr<const std::vector<Node>> AsyncDStarLite::latestPath() const {
+    return std::atomic_load(&front);
+}
+
+std::uint64_t AsyncDStarLite::pathVersion() const {
+    return version.load(std::memory_order_acquire);
+}
+
+void AsyncDStarLite::run(Node start, Node goal) {
+    publish(planner.findPath(start, goal));
+
+    Node agentNode;
+    std::vector<Node> updatedNodes;
+
+    while (running) {
+        if (coalesceUpdates(agentNode, updatedNodes)) {
+            for (const Node& node : updatedNodes) 
+                graph.setWalkable(node, node.walkable);
+            graph.updateConnectivity();
+
+            publish(planner.notifyEnvironmentChanges(agentNode, updatedNodes));
+        } else if (planner.deferredCount() > 0) { // idle: finish the far-field repair
+            publish(planner.resumeDeferred());
+        } else {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [this] { 
+                return !running || !updates.isEmpty(); 
+            });
+        }
+    }
+}
+
+// Every path gets its own allocation and is never written after the swap. A reader may still
+// be copying the previous pointer when the swap happens, so use_count() cannot tell when a
+// buffer is safe to refill.
+void AsyncDStarLite::publish(std::vector<Node> path) {
+    std::atomic_store(&front, std::shared_ptr<const std::vector<Node>>(std::make_shared<std::vector<Node>>(std::move(path))));
+    version.fetch_add(1, std::memory_order_release);
+}
+
+// Merges everything queued since the last replan into one update: the latest agent
+// position and the final state of every changed node.
+bool AsyncDStarLite::coalesceUpdates(Node& agentNode, std::vector<Node>& updatedNodes) {
+    std::unordered_map<Node, std::size_t> indices;
+    PlannerUpdate update;
+    bool received = false;
+
+    updatedNodes.clear();
+
+    while (updates.pop(update)) {
+        received = true;
+        agentNode = update.agent;
+
+        for (const Node& node : update.changes) {
+            auto it = indices.find(node);
+
+            if (it != indices.end()) {
+                updatedNodes[it->second] = node;
+            } else {
+                indices[node] = updatedNodes.size();
+                updatedNodes.push_back(node);
+            }
+        }
+    }
+
+    return received;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+// Raw host-byte-order I/O shared by the binary file formats (CSRG graphs, DSTR traces).
+// Internal to the library; not installed with the public headers.
+
+template <typename T>
+void writeRaw(std::ofstream& out, const T* data, std::size_t count) {
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+// Throws std::runtime_error(truncated) on a short read.
+template <typename T>
+void readRaw(std::ifstream& in, T* data, std::size_t count, const char* truncated) {
+    in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+    if (!in) throw std::runtime_error(truncated);
+}
+
+// Bytes between the read position and the end of the file. Loaders check counts read from a
+// file against it before allocating for them.
+inline std::uint64_t remainingBytes(std::ifstream& in) {
+    std::streampos here = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(here);
+    return static_cast<std::uint64_t>(end - here);
+}
@@ -0,0 +1,179 @@
+#include "BucketQueue.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    constexpr double KEY_LIMIT = 4294967296.0; // 2^32
+
+    constexpr std::size_t COMPACT_AFTER = 1024; // empty leading buckets tolerated before trimming
+
+    // Heap order inside a bucket: smallest packed key on top.
+    const auto after = [](const auto& a, const auto& b) { return a.key > b.key; };
+}
+
+BucketQueue::BucketQueue() : base(0), cursor(0) {}
+
+BucketQueue::BucketQueue(std::pmr::memory_resource* resource) 
+    : buckets(resource), base(0), cursor(0), nodeToKey(resource) {}
+
+std::uint64_t BucketQueue::pack(const Key& key) {
+    for (double part : {key.k1, key.k2}) 
+        if (!(0.0 <= part && part < KEY_LIMIT) || std::floor(part) != part) 
+            throw std::runtime_error("BucketQueue: keys must be whole numbers below 2^32");
+
+    return (static_cast<std::uint64_t>(key.k1) << 32) | static_cast<std::uint64_t>(key.k2);
+}
+
+Key BucketQueue::unpack(std::uint64_t packed) {
+    return Key(static_cast<double>(packed >> 32), static_cast<double>(packed & 0xffffffffULL));
+}
+
+int BucketQueue::count() const {
+    return static_cast<int>(nodeToKey.size());
+}
+
+bool BucketQueue::isEmpty() const {
+    return nodeToKey.empty();
+}
+
+const Node& BucketQueue::top() const {
+    if (isEmpty())
+        throw std::runtime_error("Heap is empty!");
+
+    return buckets[cursor].front().node;
+}
+
+const Key& BucketQueue::topKey() const {
+    if (isEmpty())
+        throw std::runtime_error("Heap is empty!");
+
+    return currentKey;
+}
+
+bool BucketQueue::contains(const Node& node) const {
+    return nodeToKey.find(node) != nodeToKey.end();
+}
+
+std::vector<Node> BucketQueue::nodes() const {
+    std::vector<Node> result;
+    result.reserve(nodeToKey.size());
+
+    for (const auto& [node, key] : nodeToKey) 
+        result.push_back(node);
+    return result;
+}
+
+void BucketQueue::insert(const Node& node, const Key& key) {
+    if (contains(node))
+        throw std::runtime_error("Duplicate node!");
+
+    std::uint64_t packed = pack(key);
+    nodeToKey[node] = packed;
+    push(packed, node);
+    settle();
+}
+
+Node BucketQueue::pop() {
+    if (isEmpty())
+        throw std::runtime_error("Heap is empty!");
+
+    std::pmr::vector<Entry>& bucket = buckets[cursor];
+    Node topNode = bucket.front().node;
+
+    std::pop_heap(bucket.begin(), bucket.end(), after);
+    bucket.pop_back();
+    nodeToKey.erase(topNode);
+    settle();
+
+    return topNode;
+}
+
+void BucketQueue::remove(const Node& node) {
+    if (!contains(node))
+        throw std::runtime_error("Node not found!");
+
+    nodeToKey.erase(node);
+    settle();
+}
+
+void BucketQueue::update(const Node& node, const Key& newKey) {
+    auto it = nodeToKey.find(node);
+    if (it == nodeToKey.end())
+        throw std::runtime_error("Node not found!");
+
+    std::uint64_t packed = pack(newKey);
+    if (it->second == packed) return; // D* Lite re-files most nodes under an unchanged key
+
+    it->second = packed;
+    push(packed, node);
+    settle();
+}
+
+void BucketQueue::reset() {
+    buckets.clear();
+    nodeToKey.clear();
+    base = 0;
+    cursor = 0;
+}
+
+// Files an entry under its k1, growing the bucket range downwards or upwards as needed.
+void BucketQueue::push(std::uint64_t key, const Node& node) {
+    std::uint64_t k1 = key >> 32;
+
+    if (buckets.empty()) {
+        base = k1;
+        cursor = 0;
+    } else if (k1 < base) {
+        // Happens after changes far from the agent; shifting costs O(buckets) but is rare.
+        std::size_t shift = static_cast<std::size_t>(base - k1);
+        buckets.insert(buckets.begin(), shift, std::pmr::vector<Entry>(buckets.get_allocator()));
+        base = k1;
+        cursor += shift;
+    }
+
+    std::size_t index = static_cast<std::size_t>(k1 - base);
+    if (index >= buckets.size()) 
+        buckets.resize(index + 1);
+
+    std::pmr::vector<Entry>& bucket = buckets[index];
+    bucket.push_back(Entry{key, node});
+    std::push_heap(bucket.begin(), bucket.end(), after);
+
+    cursor = std::min(cursor, index);
+}
+
+// Moves the cursor to the lowest live entry, dropping stale ones on the way.
+void BucketQueue::settle() {
+    if (nodeToKey.empty()) {
+        buckets.clear(); // only stale entries are left
+        cursor = 0;
+        return;
+    }
+
+    while (true) {
+        std::pmr::vector<Entry>& bucket = buckets[cursor];
+
+        while (!bucket.empty() && !live(bucket.front())) {
+            std::pop_heap(bucket.begin(), bucket.end(), after);
+            bucket.pop_back();
+        }
+
+        if (!bucket.empty()) break;
+        cursor++;
+    }
+
+    // km only grows over a mission, so keys drift upwards; drop the buckets left behind.
+    if (cursor > COMPACT_AFTER && cursor * 2 > buckets.size()) {
+        buckets.erase(buckets.begin(), buckets.begin() + cursor);
+        base += cursor;
+        cursor = 0;
+    }
+
+    currentKey = unpack(buckets[cursor].front().key);
+}
+
+bool BucketQueue::live(const Entry& entry) const {
+    auto it = nodeToKey.find(entry.node);
+    return it != nodeToKey.end() && it->second == entry.key;
+}
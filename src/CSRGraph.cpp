@@ -0,0 +1,335 @@
+#include "CSRGraph.h"
+#include "BinaryIO.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    constexpr char MAGIC[4] = {'C', 'S', 'R', 'G'};
+    constexpr std::uint32_t VERSION = 1;
+
+    constexpr const char* TRUNCATED = "CSRGraph: truncated binary file";
+
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("CSRGraph: cannot open " + path);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // Hands fn a pointer to the start of every non-empty line; fields are parsed with strto*.
+    template <typename Fn>
+    void forEachLine(const std::string& text, Fn fn) {
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            std::size_t end = text.find('\n', pos);
+            if (end == std::string::npos) end = text.size();
+            if (end > pos) fn(text.c_str() + pos);
+            pos = end + 1;
+        }
+    }
+}
+
+CSRGraph::CSRGraph(int nodeCount, const std::vector<Edge>& edges) {
+    if (nodeCount < 0) throw std::runtime_error("CSRGraph: negative node count");
+
+    offsets.assign(nodeCount + 1, 0);
+    for (const Edge& e : edges) {
+        if (!contains(e.from) || !contains(e.to)) throw std::runtime_error("CSRGraph: edge endpoint out of range");
+        offsets[e.from + 1]++;
+    }
+    for (int u = 0; u < nodeCount; u++) offsets[u + 1] += offsets[u];
+
+    targets.resize(edges.size());
+    costs.resize(edges.size());
+    std::vector<std::int64_t> cursor(offsets.begin(), offsets.end() - 1);
+
+    for (const Edge& e : edges) {
+        std::int64_t slot = cursor[e.from]++;
+        targets[slot] = e.to;
+        costs[slot] = e.cost;
+    }
+
+    open.assign(nodeCount, 1);
+    sortRows();
+    buildReverse();
+}
+
+// Stable, so parallel edges keep their input order.
+void CSRGraph::sortRows() {
+    std::vector<std::pair<std::int32_t, double>> row;
+
+    for (int u = 0; u < nodeCount(); u++) {
+        auto first = targets.begin() + offsets[u];
+        auto last = targets.begin() + offsets[u + 1];
+        if (std::is_sorted(first, last)) continue;
+
+        row.clear();
+        for (std::int64_t e = offsets[u]; e < offsets[u + 1]; e++) row.emplace_back(targets[e], costs[e]);
+        std::stable_sort(row.begin(), row.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (std::size_t i = 0; i < row.size(); i++) {
+            targets[offsets[u] + i] = row[i].first;
+            costs[offsets[u] + i] = row[i].second;
+        }
+    }
+}
+
+void CSRGraph::buildReverse() {
+    int n = nodeCount();
+    inOffsets.assign(n + 1, 0);
+    for (std::int32_t v : targets) inOffsets[v + 1]++;
+    for (int v = 0; v < n; v++) inOffsets[v + 1] += inOffsets[v];
+
+    inEdges.resize(targets.size());
+    inSources.resize(targets.size());
+    std::vector<std::int64_t> cursor(inOffsets.begin(), inOffsets.end() - 1);
+
+    for (int u = 0; u < n; u++) {
+        for (std::int64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+            std::int64_t slot = cursor[targets[e]]++;
+            inEdges[slot] = e;
+            inSources[slot] = u;
+        }
+    }
+}
+
+CSRGraph CSRGraph::loadBinary(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("CSRGraph: cannot open " + path);
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::int32_t n = 0;
+    std::int64_t m = 0;
+    std::uint8_t hasCoordinates = 0;
+
+    readRaw(in, magic, 4, TRUNCATED);
+    if (std::memcmp(magic, MAGIC, 4) != 0) throw std::runtime_error("CSRGraph: not a CSRG file");
+    readRaw(in, &version, 1, TRUNCATED);
+    if (version != VERSION) throw std::runtime_error("CSRGraph: unsupported CSRG version");
+    readRaw(in, &n, 1, TRUNCATED);
+    readRaw(in, &m, 1, TRUNCATED);
+    readRaw(in, &hasCoordinates, 1, TRUNCATED);
+    if (n < 0 || m < 0) throw std::runtime_error("CSRGraph: corrupt header");
+
+    CSRGraph graph;
+    readRaw(in, &graph.heuristicScale, 1, TRUNCATED);
+
+    // Checked before anything is allocated, so a corrupt header cannot request huge buffers.
+    std::uint64_t remaining = remainingBytes(in);
+    std::uint64_t nodes = static_cast<std::uint64_t>(n);
+    std::uint64_t nodeBytes = (nodes + 1) * sizeof(std::int64_t) + nodes * (1 + (hasCoordinates ? 2 * sizeof(double) : 0));
+    if (nodeBytes > remaining || static_cast<std::uint64_t>(m) > (remaining - nodeBytes) / (sizeof(std::int32_t) + sizeof(double)))
+        throw std::runtime_error("CSRGraph: header counts exceed the file size");
+
+    graph.offsets.resize(n + 1);
+    graph.targets.resize(m);
+    graph.costs.resize(m);
+    graph.open.resize(n);
+    readRaw(in, graph.offsets.data(), graph.offsets.size(), TRUNCATED);
+    readRaw(in, graph.targets.data(), graph.targets.size(), TRUNCATED);
+    readRaw(in, graph.costs.data(), graph.costs.size(), TRUNCATED);
+    readRaw(in, graph.open.data(), graph.open.size(), TRUNCATED);
+
+    if (hasCoordinates) {
+        graph.xs.resize(n);
+        graph.ys.resize(n);
+        readRaw(in, graph.xs.data(), graph.xs.size(), TRUNCATED);
+        readRaw(in, graph.ys.data(), graph.ys.size(), TRUNCATED);
+    }
+
+    if (graph.offsets.front() != 0 || graph.offsets.back() != m ||
+        !std::is_sorted(graph.offsets.begin(), graph.offsets.end()))
+        throw std::runtime_error("CSRGraph: corrupt offsets");
+    for (std::int32_t v : graph.targets)
+        if (!graph.contains(v)) throw std::runtime_error("CSRGraph: edge target out of range");
+
+    graph.sortRows();
+    graph.buildReverse();
+    return graph;
+}
+
+void CSRGraph::saveBinary(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("CSRGraph: cannot write " + path);
+
+    std::int32_t n = nodeCount();
+    std::int64_t m = edgeCount();
+    std::uint8_t hasCoordinates = xs.empty() ? 0 : 1;
+
+    writeRaw(out, MAGIC, 4);
+    writeRaw(out, &VERSION, 1);
+    writeRaw(out, &n, 1);
+    writeRaw(out, &m, 1);
+    writeRaw(out, &hasCoordinates, 1);
+    writeRaw(out, &heuristicScale, 1);
+    writeRaw(out, offsets.data(), offsets.size());
+    writeRaw(out, targets.data(), targets.size());
+    writeRaw(out, costs.data(), costs.size());
+    writeRaw(out, open.data(), open.size());
+
+    if (hasCoordinates) {
+        writeRaw(out, xs.data(), xs.size());
+        writeRaw(out, ys.data(), ys.size());
+    }
+
+    if (!out) throw std::runtime_error("CSRGraph: failed writing " + path);
+}
+
+CSRGraph CSRGraph::loadDimacs(const std::string& grPath) {
+    std::string text = readFile(grPath);
+    int n = -1;
+    std::vector<Edge> edges;
+
+    forEachLine(text, [&](const char* line) {
+        char* cursor = nullptr;
+
+        if (line[0] == 'p') {
+            const char* p = line + 1;
+            while (*p == ' ' || *p == '\t') p++;
+            if (std::strncmp(p, "sp", 2) != 0) throw std::runtime_error("CSRGraph: expected 'p sp' problem line");
+            n = static_cast<int>(std::strtol(p + 2, &cursor, 10));
+            long long arcs = std::strtoll(cursor, nullptr, 10);
+
+            // An arc line takes at least 8 bytes ("a 1 2 3\n"; the last one may lack the newline).
+            if (n < 0 || arcs < 0 || static_cast<unsigned long long>(arcs) > (text.size() + 1) / 8)
+                throw std::runtime_error("CSRGraph: problem line counts do not fit the file");
+            edges.reserve(static_cast<std::size_t>(arcs));
+        } else if (line[0] == 'a') {
+            if (n < 0) throw std::runtime_error("CSRGraph: arc before problem line");
+            long from = std::strtol(line + 1, &cursor, 10);
+            long to = std::strtol(cursor, &cursor, 10);
+            double cost = std::strtod(cursor, nullptr);
+            edges.push_back({static_cast<int>(from - 1), static_cast<int>(to - 1), cost});
+        }
+    });
+
+    if (n < 0) throw std::runtime_error("CSRGraph: missing problem line in " + grPath);
+    return CSRGraph(n, edges);
+}
+
+void CSRGraph::loadDimacsCoordinates(const std::string& coPath) {
+    std::string text = readFile(coPath);
+    int n = nodeCount();
+    std::vector<double> x(n, 0.0), y(n, 0.0);
+
+    forEachLine(text, [&](const char* line) {
+        if (line[0] != 'v') return;
+        char* cursor = nullptr;
+        long id = std::strtol(line + 1, &cursor, 10) - 1;
+        double vx = std::strtod(cursor, &cursor);
+        double vy = std::strtod(cursor, nullptr);
+        if (!contains(static_cast<int>(id))) throw std::runtime_error("CSRGraph: coordinate for unknown node");
+        x[id] = vx;
+        y[id] = vy;
+    });
+
+    setCoordinates(std::move(x), std::move(y), heuristicScale);
+}
+
+void CSRGraph::setCoordinates(std::vector<double> xs, std::vector<double> ys, double scale) {
+    if (static_cast<int>(xs.size()) != nodeCount() || static_cast<int>(ys.size()) != nodeCount())
+        throw std::runtime_error("CSRGraph: coordinate count does not match node count");
+    this->xs = std::move(xs);
+    this->ys = std::move(ys);
+    this->heuristicScale = scale;
+}
+
+void CSRGraph::setHeuristicScale(double scale) {
+    heuristicScale = scale;
+}
+
+int CSRGraph::nodeCount() const {
+    return static_cast<int>(open.size());
+}
+
+std::int64_t CSRGraph::edgeCount() const {
+    return static_cast<std::int64_t>(targets.size());
+}
+
+bool CSRGraph::contains(int id) const {
+    return 0 <= id && id + 1 < static_cast<int>(offsets.size());
+}
+
+std::int64_t CSRGraph::findEdge(int from, int to) const {
+    if (!contains(from)) return -1;
+
+    auto first = targets.begin() + offsets[from];
+    auto last = targets.begin() + offsets[from + 1];
+    auto it = std::lower_bound(first, last, to);
+
+    std::int64_t best = -1;
+    for (; it != last && *it == to; ++it) {
+        std::int64_t e = it - targets.begin();
+        if (best < 0 || costs[e] < costs[best]) best = e;
+    }
+    return best;
+}
+
+void CSRGraph::setEdgeCost(std::int64_t edge, double cost) {
+    costs.at(edge) = cost;
+}
+
+double CSRGraph::edgeCost(std::int64_t edge) const {
+    return costs.at(edge);
+}
+
+int CSRGraph::edgeSource(std::int64_t edge) const {
+    if (edge < 0 || edge >= edgeCount()) throw std::runtime_error("CSRGraph: edge index out of range");
+    return static_cast<int>(std::upper_bound(offsets.begin(), offsets.end(), edge) - offsets.begin()) - 1;
+}
+
+int CSRGraph::edgeTarget(std::int64_t edge) const {
+    return targets.at(edge);
+}
+
+void CSRGraph::setWalkable(const Node& node, bool walkable) {
+    if (!contains(node.row)) return;
+    open[node.row] = walkable;
+}
+
+bool CSRGraph::isWalkable(const Node& node) const {
+    return contains(node.row) && open[node.row];
+}
+
+std::vector<Node> CSRGraph::getNeighbors(const Node& node) const {
+    std::vector<Node> neighbors;
+    if (!contains(node.row)) return neighbors;
+
+    for (std::int64_t e = offsets[node.row]; e < offsets[node.row + 1]; e++) {
+        int v = targets[e];
+        if (open[v] && costs[e] < INF_COST) neighbors.emplace_back(v, 0, true);
+    }
+    return neighbors;
+}
+
+std::vector<Node> CSRGraph::getPredecessors(const Node& node) const {
+    std::vector<Node> predecessors;
+    if (!contains(node.row)) return predecessors;
+
+    for (std::int64_t i = inOffsets[node.row]; i < inOffsets[node.row + 1]; i++) {
+        int u = inSources[i];
+        if (open[u] && costs[inEdges[i]] < INF_COST) predecessors.emplace_back(u, 0, true);
+    }
+    return predecessors;
+}
+
+double CSRGraph::getEdgeCost(const Node& node1, const Node& node2) const {
+    if (!isWalkable(node1) || !isWalkable(node2)) return INF_COST;
+
+    std::int64_t e = findEdge(node1.row, node2.row);
+    return e < 0 ? INF_COST : costs[e];
+}
+
+double CSRGraph::getEuclideanDistance(const Node& node1, const Node& node2) const {
+    if (xs.empty() || !contains(node1.row) || !contains(node2.row)) return 0.0;
+
+    double dx = xs[node1.row] - xs[node2.row];
+    double dy = ys[node1.row] - ys[node2.row];
+    return heuristicScale * std::sqrt(dx * dx + dy * dy);
+}
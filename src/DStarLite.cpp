@@ -1,116 +1,349 @@
 #include "DStarLite.h"
 #include <algorithm>
+#include <cmath>
 #include <vector>
 #include <unordered_set>
 
-DStarLite::DStarLite(const IGraph& graph) : graph(graph), km(0.0) {
-    heap = MinHeapMap();
-}
+DStarLite::DStarLite(const IGraph& graph, SearchArena* arena) 
+    : graph(graph), graphHeuristic(graph), heuristic(&graphHeuristic), arena(arena), costMode(CostMode::Floating), 
+      heapQueue(resource()), deferredHeap(resource()), bucketQueue(resource()), deferredBuckets(resource()), focusRadius(IGraph::INF_COST), focusing(false), km(0.0), gCosts(resource()), rhsCosts(resource()), 
+      memoryBudget(0), stateNodes(0), cachedPathIndex(resource()) {}
 
 std::vector<Node> DStarLite::findPath(const Node& start, const Node& goal) {
     if (!start.walkable || !goal.walkable) 
         return std::vector<Node>();
 
-    this->heap.reset();
-    this->gCosts.clear();
-    this->rhsCosts.clear();
+    resetSearchState();
+    this->focusing = false;
 
     this->start = start;
-    this->last = last;
+    this->last = start;
     this->goal = goal;
     this->km = 0.0;
 
-    this->gCosts[goal] = IGraph::INF_COST;
-    this->rhsCosts[goal] = 0.0;
-    this->heap.insert(goal, calculateKey(goal));
+    setG(goal, IGraph::INF_COST);
+    setRhs(goal, 0.0);
+    this->openList().insert(goal, calculateKey(goal));
+
+    // The goal stays seeded, so a later notifyEnvironmentChanges() that opens a way through
+    // picks the search up from here.
+    if (!graph.isReachable(start, goal)) return std::vector<Node>();
 
     computeShortestPath();
-    return buildPath();
+    return finishSearch();
 }
 
 std::vector<Node> DStarLite::notifyEnvironmentChanges(const Node& agentNode, const std::vector<Node>& updatedNodes) {
-    this->km += graph.getEuclideanDistance(last, agentNode);
+    this->km += estimate(last, agentNode);
     this->start = agentNode;
     this->last = agentNode;
+    this->focusing = focusRadius < IGraph::INF_COST;
+
+    searchStats.replans++;
+
+    requeueDeferred(); // the window moved with the agent
 
+    bool pathAffected = false;
     for (const Node& node : updatedNodes) {
-        rhsCosts[node] = graph.isWalkable(node) ? computeRhs(node) : IGraph::INF_COST;
+        auto g = gCosts.find(node);
+        bool explored = g != gCosts.end() && g->second < IGraph::INF_COST;
+        bool onPath = cachedPathIndex.find(node) != cachedPathIndex.end();
+
+        // A cell the search never reached that still has no way to the goal, e.g. a newly
+        // blocked one: its rhs stays INF and nothing can depend on its INF g.
+        double rhs = graph.isWalkable(node) ? computeRhs(node) : IGraph::INF_COST;
+        if (!explored && !onPath && rhs == IGraph::INF_COST && rhsCosts.find(node) == rhsCosts.end()) {
+            searchStats.irrelevantChanges++;
+            continue;
+        }
+
+        setRhs(node, rhs);
         updateNode(node);
+        bool queued = openList().contains(node);
+        Key lowest = queued ? calculateKey(node) : Key(IGraph::INF_COST, IGraph::INF_COST);
+
+        // Every edge into the node changed too, so its predecessors' rhs may be stale. They
+        // only used the node through g(node) + cost, which is INF unless it was explored.
+        if (explored) {
+            for (const Node& neighbor : graph.getPredecessors(node)) {
+                setRhs(neighbor, computeRhs(neighbor));
+                updateNode(neighbor);
+
+                if (!openList().contains(neighbor)) continue;
+                queued = true;
+                lowest = std::min(lowest, calculateKey(neighbor));
+            }
+        }
+
+        if (onPath || (queued && lowest < calculateKey(start))) {
+            searchStats.pathChanges++;
+            pathAffected |= onPath;
+        } else if (queued) {
+            searchStats.frontierChanges++;
+        } else {
+            searchStats.irrelevantChanges++;
+        }
+    }
+
+    // The search below would stop before its first expansion, so g is unchanged and the path
+    // from the agent is the tail of the last one.
+    auto agent = cachedPathIndex.find(agentNode);
+    double startG = gCosts.find(start) != gCosts.end() ? gCosts[start] : IGraph::INF_COST;
+    double startRhs = rhsCosts.find(start) != rhsCosts.end() ? rhsCosts[start] : IGraph::INF_COST;
+    bool searchIdle = startG == startRhs && (openList().isEmpty() || !(openList().topKey() < calculateKey(start)));
+
+    if (!pathAffected && agent != cachedPathIndex.end() && searchIdle) {
+        std::vector<Node> path(cachedPath.begin() + agent->second, cachedPath.end());
+
+        if (withinFocusBound(path)) {
+            this->focusing = false;
+            searchStats.replansSkipped++;
+
+            enforceMemoryBudget(path);
+            return path;
+        }
+    }
+
+    // Every change is queued already, so skipping the search loses nothing. Checked after the
+    // shortcut above, since an intact path already proves the goal reachable.
+    if (!graph.isReachable(agentNode, goal)) {
+        this->focusing = false;
+        cachedPath.clear();
+        cachedPathIndex.clear();
+        return std::vector<Node>();
+    }
+
+    computeShortestPath();
+
+    // The window's answer rests on the g-values beyond it. A path that runs into a deferred
+    // node, or stops short of the goal, crosses the far-field change itself, so that repair
+    // cannot wait.
+    if (focusing && !deferredList().isEmpty()) {
+        std::vector<Node> path = buildPath();
+        bool intact = !path.empty() && path.back() == goal;
+        for (std::size_t i = 0; i < path.size() && intact; i++) 
+            intact = !deferredList().contains(path[i]);
+
+        if (!intact || !withinFocusBound(path)) {
+            this->focusing = false;
+            requeueDeferred();
+            computeShortestPath();
+        }
+    }
+
+    this->focusing = false;
+    return finishSearch();
+}
+
+void DStarLite::resetSearchState() {
+    if (arena == nullptr) {
+        heapQueue.reset();
+        deferredHeap.reset();
+        bucketQueue.reset();
+        deferredBuckets.reset();
+        gCosts.clear();
+        rhsCosts.clear();
+        stateNodes = 0;
+        cachedPath.clear();
+        cachedPathIndex.clear();
+        return;
     }
 
+    // Everything lives in the arena, so drop the containers wholesale instead of
+    // freeing their nodes one by one, then rewind the arena.
+    SearchArena::abandon(heapQueue, arena);
+    SearchArena::abandon(deferredHeap, arena);
+    SearchArena::abandon(bucketQueue, arena);
+    SearchArena::abandon(deferredBuckets, arena);
+    SearchArena::abandon(gCosts, arena);
+    SearchArena::abandon(rhsCosts, arena);
+    SearchArena::abandon(cachedPathIndex, arena);
+    stateNodes = 0;
+    cachedPath.clear();
+    arena->reset();
+}
+
+std::pmr::memory_resource* DStarLite::resource() const {
+    return arena != nullptr ? arena : std::pmr::get_default_resource();
+}
+
+IPriorityQueue& DStarLite::openList() {
+    return costMode == CostMode::Integer ? static_cast<IPriorityQueue&>(bucketQueue) : heapQueue;
+}
+
+IPriorityQueue& DStarLite::deferredList() {
+    return costMode == CostMode::Integer ? static_cast<IPriorityQueue&>(deferredBuckets) : deferredHeap;
+}
+
+double DStarLite::estimate(const Node& from, const Node& to) const {
+    double h = heuristic->estimate(from, to);
+    return costMode == CostMode::Integer ? std::floor(h) : h;
+}
+
+void DStarLite::setFocusRadius(double radius) {
+    this->focusRadius = radius;
+}
+
+std::vector<Node> DStarLite::resumeDeferred() {
+    this->focusing = false;
+    requeueDeferred();
     computeShortestPath();
-    return buildPath();
+    return finishSearch();
+}
+
+int DStarLite::deferredCount() const {
+    return costMode == CostMode::Integer ? deferredBuckets.count() : deferredHeap.count();
+}
+
+void DStarLite::setMemoryBudget(std::size_t maxNodes) {
+    this->memoryBudget = maxNodes;
+}
+
+std::size_t DStarLite::stateSize() const {
+    return stateNodes;
+}
+
+void DStarLite::setCostMode(CostMode mode) {
+    this->costMode = mode;
+}
+
+void DStarLite::setHeuristic(const IHeuristic* heuristic) {
+    this->heuristic = heuristic != nullptr ? heuristic : &graphHeuristic;
+}
+
+// Queued keys were computed with the old heuristic. They are no longer lower bounds, so the
+// search could stop early; recomputed keys are exact again for the current start and km.
+void DStarLite::heuristicChanged() {
+    for (IPriorityQueue* queue : {&openList(), &deferredList()}) 
+        for (const Node& node : queue->nodes()) 
+            queue->update(node, calculateKey(node));
+}
+
+const SearchStats& DStarLite::stats() const {
+    return searchStats;
+}
+
+void DStarLite::resetStats() {
+    searchStats = SearchStats();
+}
+
+bool DStarLite::inFocus(const Node& node) const {
+    return estimate(start, node) <= focusRadius;
+}
+
+// No path to the goal is cheaper than both g(start) and the lowest deferred key less km: the
+// open list has settled everything below the former, and a cheaper path would have to pass a
+// deferred node, which costs at least its key. Only valid once the open list is idle.
+bool DStarLite::withinFocusBound(const std::vector<Node>& path) {
+    if (deferredList().isEmpty()) 
+        return true;
+
+    double cost = 0.0;
+    for (std::size_t i = 1; i < path.size(); i++) 
+        cost += graph.getEdgeCost(path[i - 1], path[i]);
+
+    double startG = gCosts.find(start) != gCosts.end() ? gCosts[start] : IGraph::INF_COST;
+    double lowerBound = std::min(startG, deferredList().topKey().k1 - km);
+    return cost <= lowerBound + focusRadius + EPSILON;
+}
+
+void DStarLite::requeueDeferred() {
+    std::vector<Node> pending;
+    pending.reserve(deferredList().count());
+
+    while (!deferredList().isEmpty()) 
+        pending.push_back(deferredList().pop());
+
+    for (const Node& node : pending) // keys are recomputed against the current start and km
+        updateNode(node);
 }
 
 Key DStarLite::calculateKey(const Node& node) {
     double g = gCosts.find(node) != gCosts.end() ? gCosts[node] : IGraph::INF_COST;
     double rhs = rhsCosts.find(node) != rhsCosts.end() ? rhsCosts[node] : IGraph::INF_COST;
     double minCost = std::min(g, rhs);
-    return Key(minCost + graph.getEuclideanDistance(start, node) + km, minCost);
+    return Key(quantize(minCost + estimate(start, node) + km), quantize(minCost));
+}
+
+// Equal-cost paths can sum to values a few ulps apart, e.g. octile sums of sqrt(2) taken in a
+// different order. Keys are rounded to multiples of EPSILON, so such values compare equal and
+// the k2 tie-break applies the same way in the open list and in every key check. Integer-mode
+// keys are exact already.
+double DStarLite::quantize(double value) const {
+    if (costMode == CostMode::Integer || value == IGraph::INF_COST) return value;
+    return std::round(value / EPSILON) * EPSILON;
 }
 
 void DStarLite::updateNode(const Node& node) {
     double g = gCosts.find(node) != gCosts.end() ? gCosts[node] : IGraph::INF_COST;
     double rhs = rhsCosts.find(node) != rhsCosts.end() ? rhsCosts[node] : IGraph::INF_COST;
 
-    if (heap.contains(node) && g != rhs) {
-        heap.update(node, calculateKey(node));
-    } else if (!heap.contains(node) && g != rhs) {
-        heap.insert(node, calculateKey(node));
-    } else if (heap.contains(node) && std::fabs(g - rhs) < EPSILON) {
-        heap.remove(node);
+    // Outside the focus window, inconsistent nodes wait in the deferred queue instead.
+    IPriorityQueue& queue = focusing && !inFocus(node) ? deferredList() : openList();
+    IPriorityQueue& other = &queue == &openList() ? deferredList() : openList();
+
+    if (other.contains(node))
+        other.remove(node);
+
+    if (queue.contains(node) && g != rhs) {
+        queue.update(node, calculateKey(node));
+    } else if (!queue.contains(node) && g != rhs) {
+        queue.insert(node, calculateKey(node));
+    } else if (queue.contains(node) && (g == rhs || std::fabs(g - rhs) < EPSILON)) { // INF - INF is NaN
+        queue.remove(node);
     }
 }
 
 void DStarLite::computeShortestPath() {
-    Key startKey = calculateKey(start);
-
-    while (!heap.isEmpty()) {
+    while (!openList().isEmpty()) {
+        Key startKey = calculateKey(start); // start's g/rhs change as the search runs
 
         double startG = gCosts.find(start) != gCosts.end() ? gCosts[start] : IGraph::INF_COST;
         double startRhs = rhsCosts.find(start) != rhsCosts.end() ? rhsCosts[start] : IGraph::INF_COST;
 
-        if (!(heap.topKey() < startKey || startG != startRhs))
+        if (!(openList().topKey() < startKey || startG != startRhs))
             break;
         
-        Node node = heap.top();
-        Key oldKey = heap.topKey();
+        Node node = openList().top();
+        Key oldKey = openList().topKey();
         Key newKey = calculateKey(node);
 
         double g = gCosts.find(node) != gCosts.end() ? gCosts[node] : IGraph::INF_COST;
         double rhs = rhsCosts.find(node) != rhsCosts.end() ? rhsCosts[node] : IGraph::INF_COST;
 
         if (oldKey < newKey) {
-            heap.update(node, newKey);
+            openList().update(node, newKey);
         } else if (g > rhs) { 
-            gCosts[node] = rhs;
-            heap.pop();
+            searchStats.expansions++;
+            setG(node, rhs);
+            openList().pop();
                 
-            std::vector<Node> neighbors = graph.getNeighbors(node);
+            std::vector<Node> neighbors = graph.getPredecessors(node);
             
             for (const Node& neighbor : neighbors) {
                 if (!neighbor.walkable) continue;
 
                 double neighborRhs = rhsCosts.find(neighbor) != rhsCosts.end() ? rhsCosts[neighbor] : IGraph::INF_COST;
-                double newRhs = gCosts[node] + graph.getEdgeCost(node, neighbor);
+                double newRhs = gCosts[node] + graph.getEdgeCost(neighbor, node);
                     
                 if (newRhs < neighborRhs) 
-                    rhsCosts[neighbor] = newRhs;
+                    setRhs(neighbor, newRhs);
     
                 updateNode(neighbor);
             }
         } else if (g < rhs) {
+            searchStats.expansions++;
             double oldG = g;
-            gCosts[node] = IGraph::INF_COST;
-            heap.pop();
+            setG(node, IGraph::INF_COST);
+            openList().pop();
                 
-            std::vector<Node> neighbors = graph.getNeighbors(node);
+            std::vector<Node> neighbors = graph.getPredecessors(node);
 
             for (const Node& neighbor : neighbors) {
                 double neighborRhs = rhsCosts.find(neighbor) != rhsCosts.end() ? rhsCosts[neighbor] : IGraph::INF_COST;
 
-                if (std::fabs(neighborRhs - (oldG + graph.getEdgeCost(node, neighbor))) < EPSILON) 
-                    rhsCosts[neighbor] = computeRhs(neighbor);
+                if (std::fabs(neighborRhs - (oldG + graph.getEdgeCost(neighbor, node))) < EPSILON) 
+                    setRhs(neighbor, computeRhs(neighbor));
 
                 updateNode(neighbor);
             }
@@ -120,6 +353,105 @@ void DStarLite::computeShortestPath() {
     }
 }
 
+// Successor that gives `node` its current rhs, i.e. the next hop towards the goal.
+bool DStarLite::bestSuccessor(const Node& node, Node& successor) {
+    double best = IGraph::INF_COST;
+
+    for (const Node& neighbor : graph.getNeighbors(node)) {
+        if (!neighbor.walkable) continue;
+
+        double neighborG = gCosts.find(neighbor) != gCosts.end() ? gCosts[neighbor] : IGraph::INF_COST;
+        if (neighborG == IGraph::INF_COST) continue;
+
+        double total = neighborG + graph.getEdgeCost(node, neighbor);
+        if (total < best) {
+            best = total;
+            successor = neighbor;
+        }
+    }
+
+    return best < IGraph::INF_COST;
+}
+
+// The requeued border of an eviction pass still carries state, so one pass can end above the
+// budget; each retry keeps a smaller region. Requeued nodes are never evicted again, so every
+// pass that evicts something shrinks the evictable state and the loop ends.
+void DStarLite::enforceMemoryBudget(const std::vector<Node>& path) {
+    if (memoryBudget == 0) 
+        return;
+
+    std::size_t target = memoryBudget - memoryBudget / 4;
+    while (stateSize() > memoryBudget && evictColdState(path, target) > 0) 
+        target /= 2;
+}
+
+// Shrinks the search state towards `target` nodes. Kept: the goal, the path, every queued node,
+// then the nodes nearest the agent, each together with its chain of best successors, so no kept
+// rhs depends on an evicted g. Evicted nodes that border kept state are requeued with a fresh
+// rhs and g = INF, which makes the evicted area look unexplored: the next search re-expands
+// whatever part of it turns out to matter. Returns the number of nodes evicted.
+std::size_t DStarLite::evictColdState(const std::vector<Node>& path, std::size_t target) {
+    std::pmr::unordered_set<Node> keep(resource());
+
+    auto keepChain = [&](Node node) {
+        while (keep.insert(node).second && node != goal) {
+            Node next;
+            if (!bestSuccessor(node, next)) break;
+            node = next;
+        }
+    };
+
+    keepChain(goal);
+    keepChain(start);
+    for (const Node& node : path) keepChain(node);
+    for (const Node& node : openList().nodes()) keepChain(node);
+    for (const Node& node : deferredList().nodes()) keepChain(node);
+
+    std::vector<std::pair<double, Node>> candidates;
+    for (const auto& [node, rhs] : rhsCosts) 
+        if (keep.find(node) == keep.end()) candidates.emplace_back(estimate(start, node), node);
+    for (const auto& [node, g] : gCosts) 
+        if (keep.find(node) == keep.end() && rhsCosts.find(node) == rhsCosts.end()) 
+            candidates.emplace_back(estimate(start, node), node);
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<Node> evicted;
+    for (const auto& [distance, node] : candidates) {
+        if (keep.size() < target) keepChain(node);
+        if (keep.find(node) == keep.end()) evicted.push_back(node);
+    }
+
+    for (const Node& node : evicted) {
+        gCosts.erase(node);
+        rhsCosts.erase(node);
+    }
+    stateNodes -= evicted.size();
+
+    // Best-successor chains protect the g each kept rhs was built from, but ties and queued nodes
+    // can still lean on an evicted g. Rebuild the rhs of every kept neighbour; those that change
+    // are queued for the next search.
+    for (const Node& node : evicted) {
+        for (const Node& neighbor : graph.getPredecessors(node)) {
+            if (gCosts.find(neighbor) == gCosts.end() && rhsCosts.find(neighbor) == rhsCosts.end()) continue;
+
+            setRhs(neighbor, computeRhs(neighbor));
+            updateNode(neighbor);
+        }
+    }
+
+    for (const Node& node : evicted) {
+        double rhs = computeRhs(node);
+        if (rhs == IGraph::INF_COST) continue;
+
+        setRhs(node, rhs);
+        updateNode(node);
+    }
+
+    searchStats.evictions += static_cast<long long>(evicted.size());
+    return evicted.size();
+}
+
 double DStarLite::computeRhs(const Node& node) {
     if (node == goal) return 0.0;
     
@@ -138,8 +470,26 @@ double DStarLite::computeRhs(const Node& node) {
     return minRhs;
 }
 
+// Every g and rhs write goes through setG()/setRhs(), which count a node the first time it gets
+// either entry; evictColdState() subtracts the nodes it erases.
+void DStarLite::setG(const Node& node, double g) {
+    auto [entry, inserted] = gCosts.try_emplace(node, g);
+    if (!inserted) 
+        entry->second = g;
+    else if (rhsCosts.find(node) == rhsCosts.end()) 
+        stateNodes++;
+}
+
+void DStarLite::setRhs(const Node& node, double rhs) {
+    auto [entry, inserted] = rhsCosts.try_emplace(node, rhs);
+    if (!inserted) 
+        entry->second = rhs;
+    else if (gCosts.find(node) == gCosts.end()) 
+        stateNodes++;
+}
+
 std::vector<Node> DStarLite::buildPath() {  
-    std::unordered_set<Node> visited;
+    std::pmr::unordered_set<Node> visited(resource());
     std::vector<Node> path;
     
     Node current = start;
@@ -148,6 +498,8 @@ std::vector<Node> DStarLite::buildPath() {
     if (startG == IGraph::INF_COST) 
         return path; 
 
+    // While far-field repairs are deferred, g-values beyond the focus window can be stale
+    // enough to lead the walk in a circle; it stops at the first repeat.
     while (current != goal) {
         if (visited.find(current) != visited.end()) 
             break;
@@ -161,6 +513,8 @@ std::vector<Node> DStarLite::buildPath() {
 
         std::vector<Node> neighbors = graph.getNeighbors(current);
         double minCost = IGraph::INF_COST;
+        Node next = current;
+        double nextG = IGraph::INF_COST;
 
         for (const Node& neighbor : neighbors) {
             if (!neighbor.walkable) continue;
@@ -170,12 +524,18 @@ std::vector<Node> DStarLite::buildPath() {
             if (neighborG != IGraph::INF_COST) {
                 double totalCost = neighborG + graph.getEdgeCost(current, neighbor);
 
-                if (totalCost < minCost) {
+                // On equal-cost ties, prefer the neighbor closest to the goal.
+                bool tie = std::fabs(totalCost - minCost) < EPSILON;
+
+                if ((!tie && totalCost < minCost) || (tie && neighborG < nextG)) {
                     minCost = totalCost;
-                    current = neighbor;
+                    nextG = neighborG;
+                    next = neighbor;
                 }
             }
         }
+
+        current = next;
     }
     
     if (current == goal) 
@@ -183,3 +543,15 @@ std::vector<Node> DStarLite::buildPath() {
     
     return path;
 }
+
+std::vector<Node> DStarLite::finishSearch() {
+    std::vector<Node> path = buildPath();
+    enforceMemoryBudget(path);
+
+    cachedPath = path;
+    cachedPathIndex.clear();
+    for (std::size_t i = 0; i < cachedPath.size(); i++) 
+        cachedPathIndex[cachedPath[i]] = i;
+
+    return path;
+}
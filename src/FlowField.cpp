@@ -0,0 +1,197 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    constexpr int OFFSETS[8][2] = {
+        {-1, -1}, {-1, 0}, {-1, 1},
+        {0, -1},           {0, 1},
+        {1, -1},  {1, 0},  {1, 1}
+    };
+}
+
+FlowField::FlowField(const Grid& grid, const Node& goal)
+    : grid(grid), rows(grid.getRows()), cols(grid.getCols()) {
+    setGoal(goal);
+}
+
+void FlowField::setGoal(const Node& goal) {
+    if (!(0 <= goal.row && goal.row < rows && 0 <= goal.col && goal.col < cols))
+        throw std::runtime_error("FlowField: goal outside the grid");
+
+    this->goal = Node(goal.row, goal.col);
+    this->goalCell = goal.row * cols + goal.col;
+
+    int cells = rows * cols;
+    g.assign(cells, IGraph::INF_COST);
+    rhs.assign(cells, IGraph::INF_COST);
+    packed.assign((cells + DIRECTIONS_PER_WORD - 1) / DIRECTIONS_PER_WORD, 0);
+    open = decltype(open)();
+    touched.clear();
+    isTouched.assign(cells, 0);
+
+    updateCell(goalCell);
+    computeField();
+
+    for (int cell : touched) isTouched[cell] = 0;
+    touched.clear();
+    for (int cell = 0; cell < cells; cell++) setDirection(cell);
+}
+
+void FlowField::update(const std::vector<Node>& updatedNodes) {
+    // A changed cell alters its own edges, so both it and every neighbour may have a new rhs,
+    // and their directions may point elsewhere even where no cost moves.
+    for (const Node& node : updatedNodes) {
+        if (!(0 <= node.row && node.row < rows && 0 <= node.col && node.col < cols)) continue;
+
+        int cell = node.row * cols + node.col;
+        touch(cell);
+        updateCell(cell);
+
+        for (const auto& offset : OFFSETS) {
+            int row = node.row + offset[0];
+            int col = node.col + offset[1];
+            if (0 <= row && row < rows && 0 <= col && col < cols) updateCell(row * cols + col);
+        }
+    }
+
+    computeField();
+    refreshDirections();
+}
+
+Node FlowField::nextStep(const Node& node) const {
+    if (!(0 <= node.row && node.row < rows && 0 <= node.col && node.col < cols)) return node;
+
+    int cell = node.row * cols + node.col;
+    if (cell == goalCell || g[cell] == IGraph::INF_COST) return node;
+
+    int shift = DIRECTION_BITS * (cell % DIRECTIONS_PER_WORD);
+    int direction = static_cast<int>((packed[cell / DIRECTIONS_PER_WORD] >> shift) & 7u);
+    return Node(node.row + OFFSETS[direction][0], node.col + OFFSETS[direction][1]);
+}
+
+double FlowField::cost(const Node& node) const {
+    if (!(0 <= node.row && node.row < rows && 0 <= node.col && node.col < cols)) return IGraph::INF_COST;
+    return g[node.row * cols + node.col];
+}
+
+const std::vector<double>& FlowField::costs() const {
+    return g;
+}
+
+const std::vector<std::uint64_t>& FlowField::directions() const {
+    return packed;
+}
+
+const Node& FlowField::getGoal() const {
+    return goal;
+}
+
+long long FlowField::expansions() const {
+    return expanded;
+}
+
+// LPA* without a start: the queue is drained, so every reachable cell ends consistent.
+// Entries are lazy; one whose key no longer matches its cell is skipped.
+void FlowField::computeField() {
+    while (!open.empty()) {
+        auto [key, cell] = open.top();
+        open.pop();
+
+        if (g[cell] == rhs[cell] || key != std::min(g[cell], rhs[cell])) continue;
+        expanded++;
+        touch(cell);
+
+        // Edges are symmetric, so a neighbour's rhs only needs the edge back to this cell: a
+        // lowered cost can only relax it, a raised one only matters where it was the minimum.
+        double previous = g[cell];
+        bool lowered = previous > rhs[cell];
+        g[cell] = lowered ? rhs[cell] : IGraph::INF_COST;
+        if (!lowered) updateCell(cell);
+
+        for (int direction = 0; direction < 8; direction++) {
+            int neighbor = -1;
+            double cost = edgeCost(cell, direction, neighbor);
+            if (neighbor < 0 || neighbor == goalCell) continue;
+
+            if (lowered) {
+                if (cost + g[cell] >= rhs[neighbor]) continue;
+                rhs[neighbor] = cost + g[cell];
+                if (g[neighbor] != rhs[neighbor]) open.emplace(std::min(g[neighbor], rhs[neighbor]), neighbor);
+            } else if (std::fabs(rhs[neighbor] - (cost + previous)) < EPSILON) {
+                updateCell(neighbor);
+            }
+        }
+    }
+}
+
+void FlowField::updateCell(int cell) {
+    if (cell == goalCell) {
+        rhs[cell] = grid.isWalkable(goal) ? 0.0 : IGraph::INF_COST;
+    } else {
+        double best = IGraph::INF_COST;
+        for (int direction = 0; direction < 8; direction++) {
+            int neighbor = -1;
+            double cost = edgeCost(cell, direction, neighbor);
+            if (neighbor >= 0) best = std::min(best, cost + g[neighbor]);
+        }
+        rhs[cell] = best;
+    }
+
+    if (g[cell] != rhs[cell]) open.emplace(std::min(g[cell], rhs[cell]), cell);
+}
+
+// A cell's best successor depends only on its edges and its neighbours' costs, so touched
+// cells and their neighbours are the only ones that can change direction.
+void FlowField::refreshDirections() {
+    for (int cell : touched) {
+        isTouched[cell] = 0;
+        setDirection(cell);
+
+        int row = cell / cols;
+        int col = cell % cols;
+        for (const auto& offset : OFFSETS) {
+            int r = row + offset[0];
+            int c = col + offset[1];
+            if (0 <= r && r < rows && 0 <= c && c < cols) setDirection(r * cols + c);
+        }
+    }
+    touched.clear();
+}
+
+void FlowField::setDirection(int cell) {
+    int best = 0;
+    double bestCost = IGraph::INF_COST;
+    for (int direction = 0; direction < 8; direction++) {
+        int neighbor = -1;
+        double cost = edgeCost(cell, direction, neighbor);
+        if (neighbor >= 0 && cost + g[neighbor] < bestCost) {
+            best = direction;
+            bestCost = cost + g[neighbor];
+        }
+    }
+
+    int shift = DIRECTION_BITS * (cell % DIRECTIONS_PER_WORD);
+    std::uint64_t& word = packed[cell / DIRECTIONS_PER_WORD];
+    word = (word & ~(std::uint64_t{7} << shift)) | (static_cast<std::uint64_t>(best) << shift);
+}
+
+void FlowField::touch(int cell) {
+    if (isTouched[cell]) return;
+    isTouched[cell] = 1;
+    touched.push_back(cell);
+}
+
+// Sets neighbor to -1 when the move leaves the grid.
+double FlowField::edgeCost(int cell, int direction, int& neighbor) const {
+    int row = cell / cols + OFFSETS[direction][0];
+    int col = cell % cols + OFFSETS[direction][1];
+    if (!(0 <= row && row < rows && 0 <= col && col < cols)) {
+        neighbor = -1;
+        return IGraph::INF_COST;
+    }
+
+    neighbor = row * cols + col;
+    return grid.getEdgeCost(Node(cell / cols, cell % cols), Node(row, col));
+}
@@ -1,19 +1,311 @@
 #include "Grid.h"
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
 
-Grid::Grid(int rows, int cols) : rows(rows), cols(cols) {
+Grid::Grid(int rows, int cols) : rows(rows), cols(cols), straightCost(STRAIGHT_COST), diagonalCost(DIAGONAL_COST) {
     grid.resize(rows, std::vector<Node>(cols));
 
     for (int r = 0; r < rows; r++) 
         for (int c = 0; c < cols; c++) 
             grid[r][c] = Node(r, c, true);
+
+    tileRows = (rows + TILE - 1) / TILE;
+    tileCols = (cols + TILE - 1) / TILE;
+    localLabel.assign(static_cast<std::size_t>(rows) * cols, BLOCKED);
+    edited.assign(static_cast<std::size_t>(rows) * cols, 0);
+    tileComponents.assign(tileRows * tileCols, 0);
+    labelIds.resize(tileRows * tileCols);
+    tileDirty.assign(tileRows * tileCols, 1);
+    tileLinks.resize(tileRows * tileCols);
+    linksDirty.assign(tileRows * tileCols, 1);
+    componentsDirty = true;
+    splitPending = true; // the first update builds the index from scratch
 }
 
 void Grid::setWalkable(const Node& node, bool walkable) {
     if (!(0 <= node.row && node.row < rows && 0 <= node.col && node.col < cols)) return;
 
     Node& n = grid[node.row][node.col];
+    if (n.walkable == walkable) return;
+
     n.walkable = walkable;
+    edited[node.row * cols + node.col] = 1;
+    tileDirty[(node.row / TILE) * tileCols + node.col / TILE] = 1;
+    componentsDirty = true;
+    if (!walkable && maySplit(node)) splitPending = true;
+}
+
+void Grid::setCostScale(double straight, double diagonal) {
+    if (!(0.0 < straight && straight <= diagonal && diagonal <= 2.0 * straight))
+        throw std::runtime_error("Grid: cost scale needs 0 < straight <= diagonal <= 2 * straight");
+
+    this->straightCost = straight;
+    this->diagonalCost = diagonal;
+}
+
+bool Grid::isReachable(const Node& from, const Node& to) const {
+    if (componentsDirty) return true; // stale index: let the planner find out
+
+    int component = componentOf(from);
+    return component != BLOCKED && component == componentOf(to);
+}
+
+int Grid::componentOf(const Node& node) const {
+    if (!(0 <= node.row && node.row < rows && 0 <= node.col && node.col < cols)) return BLOCKED;
+    if (!grid[node.row][node.col].walkable) return BLOCKED;
+    if (componentsDirty) throw std::runtime_error("Grid: connectivity index is stale, call updateConnectivity() first");
+
+    int tile = (node.row / TILE) * tileCols + node.col / TILE;
+    return findComponent(labelIds[tile][localLabel[node.row * cols + node.col]]);
+}
+
+void Grid::updateConnectivity() {
+    if (!componentsDirty) return;
+
+    // Dead elements pile up as labels vanish; a rebuild also compacts them.
+    std::size_t live = std::accumulate(tileComponents.begin(), tileComponents.end(), std::size_t{0});
+    bool rebuild = splitPending || parent.size() > 2 * live + 1024;
+
+    std::vector<int> oldLabels;
+    std::vector<int> oldIds;
+
+    // A relabelled tile invalidates its own links and those of every tile that links into it:
+    // the ones to its left and in the tile row above.
+    for (int tile = 0; tile < tileRows * tileCols; tile++) {
+        if (!tileDirty[tile]) continue;
+
+        int row0 = (tile / tileCols) * TILE;
+        int col0 = (tile % tileCols) * TILE;
+        int row1 = std::min(row0 + TILE, rows);
+        int col1 = std::min(col0 + TILE, cols);
+
+        // The old labels of untouched cells, for remapTile().
+        oldLabels.clear();
+        for (int r = row0; r < row1; r++) {
+            for (int c = col0; c < col1; c++) {
+                if (!rebuild) oldLabels.push_back(edited[r * cols + c] ? BLOCKED : localLabel[r * cols + c]);
+                edited[r * cols + c] = 0;
+            }
+        }
+
+        if (rebuild) {
+            labelTile(tile);
+        } else {
+            oldIds = labelIds[tile];
+            labelTile(tile);
+            remapTile(tile, oldLabels, oldIds);
+        }
+        tileDirty[tile] = 0;
+
+        int tr = tile / tileCols;
+        int tc = tile % tileCols;
+        linksDirty[tile] = 1;
+        if (tc > 0) linksDirty[tile - 1] = 1;
+        if (tr > 0) {
+            for (int dc = -1; dc <= 1; dc++) 
+                if (0 <= tc + dc && tc + dc < tileCols) linksDirty[tile - tileCols + dc] = 1;
+        }
+    }
+
+    for (int tile = 0; tile < tileRows * tileCols; tile++) {
+        if (!linksDirty[tile]) continue;
+        linkTile(tile);
+        linksDirty[tile] = 0;
+
+        if (rebuild) continue;
+        for (const Link& link : tileLinks[tile]) 
+            unite(labelIds[tile][link.label], labelIds[link.tile][link.otherLabel]);
+    }
+
+    if (rebuild) rebuildComponents();
+
+    componentsDirty = false;
+    splitPending = false;
+}
+
+// Without a possible split, cells that were walkable before the batch and untouched by it are
+// still connected as they were, so each new label inherits their elements and joins them.
+// Labels made only of edited cells get a fresh element.
+void Grid::remapTile(int tile, const std::vector<int>& oldLabels, const std::vector<int>& oldIds) {
+    int row0 = (tile / tileCols) * TILE;
+    int col0 = (tile % tileCols) * TILE;
+    int width = std::min(TILE, cols - col0);
+
+    std::vector<int>& ids = labelIds[tile];
+    ids.assign(tileComponents[tile], -1);
+
+    for (std::size_t i = 0; i < oldLabels.size(); i++) {
+        int label = localLabel[(row0 + static_cast<int>(i) / width) * cols + col0 + static_cast<int>(i) % width];
+        if (label == BLOCKED || oldLabels[i] == BLOCKED) continue;
+
+        int id = oldIds[oldLabels[i]];
+        if (ids[label] == -1) ids[label] = id;
+        else unite(ids[label], id);
+    }
+
+    for (int& id : ids) {
+        if (id != -1) continue;
+        id = static_cast<int>(parent.size());
+        parent.push_back(id);
+        componentSize.push_back(1);
+    }
+}
+
+void Grid::rebuildComponents() {
+    parent.clear();
+    componentSize.clear();
+
+    for (int tile = 0; tile < tileRows * tileCols; tile++) {
+        labelIds[tile].resize(tileComponents[tile]);
+        for (int& id : labelIds[tile]) {
+            id = static_cast<int>(parent.size());
+            parent.push_back(id);
+        }
+    }
+    componentSize.assign(parent.size(), 1);
+
+    for (int tile = 0; tile < tileRows * tileCols; tile++) 
+        for (const Link& link : tileLinks[tile]) 
+            unite(labelIds[tile][link.label], labelIds[link.tile][link.otherLabel]);
+
+    // Flatten once so queries stay one hop until the next merges.
+    for (std::size_t id = 0; id < parent.size(); id++) 
+        parent[id] = findComponent(static_cast<int>(id));
+}
+
+// Blocking a cell only disconnects something if its walkable neighbours are not connected
+// among themselves around it. Walking the ring N, NE, E, ..., NW, a blocked corner still
+// joins its two edge cells, which touch diagonally; more than one run means a possible split.
+bool Grid::maySplit(const Node& node) const {
+    constexpr int RING[8][2] = {{-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}};
+
+    bool open[8];
+    for (int i = 0; i < 8; i++) open[i] = isWalkable(Node(node.row + RING[i][0], node.col + RING[i][1]));
+
+    bool joined[8];
+    for (int i = 0; i < 8; i++) joined[i] = open[i] || (i % 2 == 1 && open[i - 1] && open[(i + 1) % 8]);
+
+    int runs = 0;
+    for (int i = 0; i < 8; i++) 
+        if (joined[i] && !joined[(i + 7) % 8]) runs++;
+
+    return runs > 1;
+}
+// Flood fills the walkable cells of one tile with 8-connectivity, matching getNeighbors().
+// Works on a copy of the tile framed by a blocked border, so the fill needs no bounds checks.
+void Grid::labelTile(int tile) {
+    constexpr int WIDTH = TILE + 2;
+    constexpr int OFFSETS[8] = {-WIDTH - 1, -WIDTH, -WIDTH + 1, -1, 1, WIDTH - 1, WIDTH, WIDTH + 1};
+
+    int row0 = (tile / tileCols) * TILE;
+    int col0 = (tile % tileCols) * TILE;
+    int height = std::min(TILE, rows - row0);
+    int width = std::min(TILE, cols - col0);
+
+    std::array<int, WIDTH * WIDTH> label;
+    label.fill(BLOCKED - 1); // outside the tile or unwalkable
+    for (int r = 0; r < height; r++) 
+        for (int c = 0; c < width; c++) 
+            if (grid[row0 + r][col0 + c].walkable) label[(r + 1) * WIDTH + c + 1] = BLOCKED;
+
+    std::array<int, TILE * TILE> stack;
+    int count = 0;
+
+    for (int r = 0; r < height; r++) {
+        for (int c = 0; c < width; c++) {
+            int seed = (r + 1) * WIDTH + c + 1;
+            if (label[seed] != BLOCKED) continue;
+
+            int size = 0;
+            label[seed] = count;
+            stack[size++] = seed;
+
+            while (size > 0) {
+                int cell = stack[--size];
+                for (int offset : OFFSETS) {
+                    if (label[cell + offset] != BLOCKED) continue;
+                    label[cell + offset] = count;
+                    stack[size++] = cell + offset;
+                }
+            }
+
+            count++;
+        }
+    }
+
+    for (int r = 0; r < height; r++) 
+        for (int c = 0; c < width; c++) 
+            localLabel[(row0 + r) * cols + col0 + c] = std::max(label[(r + 1) * WIDTH + c + 1], BLOCKED);
+
+    tileComponents[tile] = count;
+}
+
+// Collects the distinct label pairs across the tile's right border (same tile row) and its
+// lower border (including the diagonal corners), so every cross-tile edge has one owner.
+void Grid::linkTile(int tile) {
+    int row0 = (tile / tileCols) * TILE;
+    int col0 = (tile % tileCols) * TILE;
+    int row1 = std::min(row0 + TILE, rows);
+    int col1 = std::min(col0 + TILE, cols);
+
+    tileLinks[tile].clear();
+
+    if (col1 < cols) {
+        for (int r = row0; r < row1; r++) 
+            for (int dr = -1; dr <= 1; dr++) 
+                if (row0 <= r + dr && r + dr < row1) addLink(tile, r, col1 - 1, r + dr, col1);
+    }
+
+    if (row1 < rows) {
+        for (int c = col0; c < col1; c++) 
+            for (int dc = -1; dc <= 1; dc++) 
+                addLink(tile, row1 - 1, c, row1, c + dc);
+    }
+
+    std::vector<Link>& links = tileLinks[tile];
+    auto order = [](const Link& a, const Link& b) {
+        return std::tie(a.label, a.tile, a.otherLabel) < std::tie(b.label, b.tile, b.otherLabel);
+    };
+    auto same = [](const Link& a, const Link& b) {
+        return a.label == b.label && a.tile == b.tile && a.otherLabel == b.otherLabel;
+    };
+    std::sort(links.begin(), links.end(), order);
+    links.erase(std::unique(links.begin(), links.end(), same), links.end());
+}
+
+void Grid::addLink(int tile, int row1, int col1, int row2, int col2) {
+    if (!(0 <= col2 && col2 < cols)) return;
+    if (!grid[row1][col1].walkable || !grid[row2][col2].walkable) return;
+
+    int otherTile = (row2 / TILE) * tileCols + col2 / TILE;
+    tileLinks[tile].push_back(Link{localLabel[row1 * cols + col1], otherTile, localLabel[row2 * cols + col2]});
+}
+
+// Read-only walk to the root; union by size keeps it logarithmic between rebuilds.
+int Grid::findComponent(int id) const {
+    while (parent[id] != id) id = parent[id];
+    return id;
+}
+
+void Grid::unite(int a, int b) {
+    a = findComponent(a);
+    b = findComponent(b);
+    if (a == b) return;
+
+    if (componentSize[a] < componentSize[b]) std::swap(a, b);
+    parent[b] = a;
+    componentSize[a] += componentSize[b];
+}
+
+int Grid::getRows() const {
+    return rows;
+}
+
+int Grid::getCols() const {
+    return cols;
 }
 
 bool Grid::isWalkable(const Node& node) const {
@@ -52,7 +344,13 @@ double Grid::getEdgeCost(const Node& node1, const Node& node2) const {
     if (dr + dc > 2) 
         return std::numeric_limits<double>::infinity();
 
-    return dr == 1 && dc == 1 ? DIAGONAL_COST : STRAIGHT_COST;
+    return dr == 1 && dc == 1 ? diagonalCost : straightCost;
+}
+
+double Grid::getHeuristic(const Node& node1, const Node& node2) const {
+    int dr = std::abs(node1.row - node2.row);
+    int dc = std::abs(node1.col - node2.col);
+    return straightCost * std::max(dr, dc) + (diagonalCost - straightCost) * std::min(dr, dc);
 }
 
 double Grid::getEuclideanDistance(const Node& node1, const Node& node2) const {
@@ -0,0 +1,184 @@
+#include "InflationLayer.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    constexpr int OFFSETS[8][2] = {
+        {-1, -1}, {-1, 0}, {-1, 1},
+        {0, -1},           {0, 1},
+        {1, -1},  {1, 0},  {1, 1}
+    };
+}
+
+InflationLayer::InflationLayer(Grid& grid, double robotRadius)
+    : grid(grid), radius(robotRadius), rows(grid.getRows()), cols(grid.getCols()) {
+    if (robotRadius < 0.0) throw std::runtime_error("InflationLayer: negative robot radius");
+
+    radiusSquared = static_cast<std::int64_t>(std::floor(robotRadius * robotRadius));
+    std::int64_t reach = static_cast<std::int64_t>(std::ceil(robotRadius)) + 1;
+    limitSquared = reach * reach;
+
+    int cells = rows * cols;
+    occupied.assign(cells, 0);
+    nearest.assign(cells, NO_OBSTACLE);
+    distSquared.assign(cells, FAR);
+    toRaise.assign(cells, 0);
+    blocked.assign(cells, 0);
+    isTouched.assign(cells, 0);
+
+    for (int cell = 0; cell < cells; cell++)
+        if (!grid.isWalkable(Node(cell / cols, cell % cols))) setObstacle(cell);
+
+    propagate();
+
+    for (int cell : touched) {
+        isTouched[cell] = 0;
+        blocked[cell] = inflated(cell);
+        if (blocked[cell]) grid.setWalkable(Node(cell / cols, cell % cols), false);
+    }
+    touched.clear();
+    grid.updateConnectivity();
+}
+
+std::vector<Node> InflationLayer::update(const std::vector<Node>& obstacleChanges) {
+    for (const Node& node : obstacleChanges) {
+        if (!(0 <= node.row && node.row < rows && 0 <= node.col && node.col < cols)) continue;
+
+        int cell = node.row * cols + node.col;
+        bool obstacle = !node.walkable;
+
+        if (obstacle && !occupied[cell]) setObstacle(cell);
+        else if (!obstacle && occupied[cell]) removeObstacle(cell);
+    }
+
+    propagate();
+
+    // Only cells whose distance moved can flip, and only those that crossed the radius do.
+    std::vector<Node> changes;
+    for (int cell : touched) {
+        isTouched[cell] = 0;
+        bool nowBlocked = inflated(cell);
+        if (nowBlocked == static_cast<bool>(blocked[cell])) continue;
+
+        blocked[cell] = nowBlocked;
+        Node node(cell / cols, cell % cols, !nowBlocked);
+        grid.setWalkable(node, !nowBlocked);
+        changes.push_back(node);
+    }
+    touched.clear();
+    grid.updateConnectivity();
+
+    return changes;
+}
+
+bool InflationLayer::isObstacle(const Node& node) const {
+    return 0 <= node.row && node.row < rows && 0 <= node.col && node.col < cols && occupied[node.row * cols + node.col];
+}
+
+double InflationLayer::clearance(const Node& node) const {
+    if (!(0 <= node.row && node.row < rows && 0 <= node.col && node.col < cols)) return 0.0;
+
+    std::int64_t d = distSquared[node.row * cols + node.col];
+    return d == FAR ? IGraph::INF_COST : std::sqrt(static_cast<double>(d));
+}
+
+double InflationLayer::getRadius() const {
+    return radius;
+}
+
+void InflationLayer::setObstacle(int cell) {
+    occupied[cell] = 1;
+    nearest[cell] = cell;
+    distSquared[cell] = 0;
+    toRaise[cell] = 0;
+    touch(cell);
+    open.push({0, cell});
+}
+
+void InflationLayer::removeObstacle(int cell) {
+    occupied[cell] = 0;
+    nearest[cell] = NO_OBSTACLE;
+    distSquared[cell] = FAR;
+    toRaise[cell] = 1;
+    touch(cell);
+    open.push({0, cell});
+}
+
+void InflationLayer::propagate() {
+    while (!open.empty()) {
+        auto [key, cell] = open.top();
+        open.pop();
+
+        if (toRaise[cell]) {
+            raise(cell);
+        } else if (key == distSquared[cell] && nearest[cell] != NO_OBSTACLE && occupied[nearest[cell]]) {
+            lower(cell);
+        }
+    }
+}
+
+// Clears every neighbour that inherited a removed obstacle; neighbours with a valid obstacle
+// are queued so they can re-grow into the cleared region.
+void InflationLayer::raise(int cell) {
+    int row = cell / cols;
+    int col = cell % cols;
+
+    for (const auto& [dr, dc] : OFFSETS) {
+        int r = row + dr;
+        int c = col + dc;
+        if (!(0 <= r && r < rows && 0 <= c && c < cols)) continue;
+
+        int neighbor = r * cols + c;
+        if (nearest[neighbor] == NO_OBSTACLE || toRaise[neighbor]) continue;
+
+        open.push({distSquared[neighbor], neighbor});
+
+        if (!occupied[nearest[neighbor]]) {
+            nearest[neighbor] = NO_OBSTACLE;
+            distSquared[neighbor] = FAR;
+            toRaise[neighbor] = 1;
+            touch(neighbor);
+        }
+    }
+
+    toRaise[cell] = 0;
+}
+
+void InflationLayer::lower(int cell) {
+    int row = cell / cols;
+    int col = cell % cols;
+    int obstacle = nearest[cell];
+
+    for (const auto& [dr, dc] : OFFSETS) {
+        int r = row + dr;
+        int c = col + dc;
+        if (!(0 <= r && r < rows && 0 <= c && c < cols)) continue;
+
+        int neighbor = r * cols + c;
+        if (toRaise[neighbor]) continue;
+
+        std::int64_t d = squaredDistance(obstacle, neighbor);
+        if (d < distSquared[neighbor] && d <= limitSquared) {
+            nearest[neighbor] = obstacle;
+            distSquared[neighbor] = d;
+            touch(neighbor);
+            open.push({d, neighbor});
+        }
+    }
+}
+
+void InflationLayer::touch(int cell) {
+    if (isTouched[cell]) return;
+    isTouched[cell] = 1;
+    touched.push_back(cell);
+}
+
+bool InflationLayer::inflated(int cell) const {
+    return distSquared[cell] <= radiusSquared;
+}
+
+std::int64_t InflationLayer::squaredDistance(int a, int b) const {
+    std::int64_t dr = a / cols - b / cols;
+    std::int64_t dc = a % cols - b % cols;
+    return dr * dr + dc * dc;
+}
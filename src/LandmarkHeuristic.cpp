@@ -0,0 +1,203 @@
+#include "LandmarkHeuristic.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+
+LandmarkHeuristic::LandmarkHeuristic(const Grid& grid, const std::vector<Node>& landmarks) 
+    : grid(grid), landmarks(landmarks), tables(landmarks.size()) {
+    for (const Node& landmark : landmarks) 
+        if (!grid.isWalkable(landmark))
+            throw std::runtime_error("Landmark is not walkable!");
+
+    recompute();
+}
+
+LandmarkHeuristic::LandmarkHeuristic(const Grid& grid, int landmarkCount) 
+    : LandmarkHeuristic(grid, selectLandmarks(grid, landmarkCount)) {}
+
+double LandmarkHeuristic::estimate(const Node& from, const Node& to) const {
+    double best = grid.getHeuristic(from, to);
+    int a = index(from);
+    int b = index(to);
+
+    for (const Table& table : tables) {
+        std::uint16_t qa = table.steps[a];
+        std::uint16_t qb = table.steps[b];
+
+        if (qa == UNREACHABLE || qb == UNREACHABLE) continue;
+
+        // One step is lost to rounding, so only the remaining difference is a lower bound.
+        int steps = std::abs(static_cast<int>(qa) - static_cast<int>(qb)) - 1;
+        best = std::max(best, steps * table.stepWeight);
+    }
+
+    return best;
+}
+
+// A table stays admissible and consistent as long as every walkable cell was walkable when
+// it was computed: the current metric then never undercuts the table's. Blocking cells and
+// reopening them is free; only a cell that is new to the table and touches cells the
+// landmark reaches can create a shortcut, and that table is recomputed in full. The 16-bit
+// steps are floors, so repairing only the region behind the shortcut from them would
+// compound rounding error past the one step the estimate allows for.
+bool LandmarkHeuristic::notifyEnvironmentChanges(const std::vector<Node>& updatedNodes) {
+    std::vector<int> stale;
+
+    for (int i = 0; i < static_cast<int>(tables.size()); i++) {
+        for (const Node& node : updatedNodes) {
+            if (grid.isWalkable(node) && !wasWalkable(tables[i], index(node)) && shortensPaths(tables[i], node)) {
+                stale.push_back(i);
+                break;
+            }
+        }
+    }
+
+    recomputeTables(stale);
+    return !stale.empty();
+}
+
+void LandmarkHeuristic::recompute() {
+    std::vector<int> all(landmarks.size());
+    for (int i = 0; i < static_cast<int>(all.size()); i++) 
+        all[i] = i;
+
+    recomputeTables(all);
+}
+
+const std::vector<Node>& LandmarkHeuristic::getLandmarks() const {
+    return landmarks;
+}
+
+std::size_t LandmarkHeuristic::memoryBytes() const {
+    std::size_t total = 0;
+
+    for (const Table& table : tables) 
+        total += table.steps.size() * sizeof(std::uint16_t);
+
+    return total;
+}
+
+std::vector<Node> LandmarkHeuristic::selectLandmarks(const Grid& grid, int count) {
+    std::vector<Node> walkable;
+
+    for (int r = 0; r < grid.getRows(); r++) 
+        for (int c = 0; c < grid.getCols(); c++) 
+            if (grid.isWalkable(Node(r, c))) 
+                walkable.push_back(Node(r, c));
+
+    std::vector<Node> selected;
+    if (walkable.empty() || count <= 0) 
+        return selected;
+
+    // Start from the walkable cell nearest the top-left corner, then repeatedly take the
+    // cell farthest from everything selected so far.
+    selected.push_back(walkable.front());
+    std::vector<double> nearest(walkable.size(), IGraph::INF_COST);
+
+    while (static_cast<int>(selected.size()) < count) {
+        std::size_t farthest = 0;
+
+        for (std::size_t i = 0; i < walkable.size(); i++) {
+            nearest[i] = std::min(nearest[i], grid.getEuclideanDistance(walkable[i], selected.back()));
+            if (nearest[i] > nearest[farthest]) 
+                farthest = i;
+        }
+
+        if (nearest[farthest] == 0.0) break; // fewer walkable cells than landmarks
+        selected.push_back(walkable[farthest]);
+    }
+
+    return selected;
+}
+
+void LandmarkHeuristic::computeTable(int landmark) {
+    int size = grid.getRows() * grid.getCols();
+    std::vector<double> dist(size, IGraph::INF_COST);
+    double minEdge = IGraph::INF_COST;
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    dist[index(landmarks[landmark])] = 0.0;
+    open.push(Entry(0.0, index(landmarks[landmark])));
+
+    while (!open.empty()) {
+        auto [d, i] = open.top();
+        open.pop();
+
+        if (d > dist[i]) continue;
+
+        Node node(i / grid.getCols(), i % grid.getCols());
+
+        for (const Node& neighbor : grid.getNeighbors(node)) {
+            double cost = grid.getEdgeCost(node, neighbor);
+            int j = index(neighbor);
+            minEdge = std::min(minEdge, cost);
+
+            if (d + cost < dist[j]) {
+                dist[j] = d + cost;
+                open.push(Entry(dist[j], j));
+            }
+        }
+    }
+
+    double maxDist = 0.0;
+    for (double d : dist) 
+        if (d != IGraph::INF_COST) maxDist = std::max(maxDist, d);
+
+    Table& table = tables[landmark];
+    table.scale = maxDist > 0.0 ? maxDist / MAX_STEPS : 1.0;
+
+    // Rounding can make neighbouring cells differ by one extra step; shrinking the step
+    // weight by minEdge / (minEdge + scale) absorbs that, so h stays consistent.
+    if (minEdge == IGraph::INF_COST) minEdge = 1.0;
+    table.stepWeight = table.scale * minEdge / (minEdge + table.scale);
+
+    table.walkable.assign((size + 63) / 64, 0);
+    for (int i = 0; i < size; i++) 
+        if (grid.isWalkable(Node(i / grid.getCols(), i % grid.getCols()))) 
+            table.walkable[i / 64] |= std::uint64_t{1} << (i % 64);
+
+    table.steps.assign(size, UNREACHABLE);
+    for (int i = 0; i < size; i++) 
+        if (dist[i] != IGraph::INF_COST) 
+            table.steps[i] = static_cast<std::uint16_t>(std::min<double>(MAX_STEPS, std::floor(dist[i] / table.scale)));
+}
+
+void LandmarkHeuristic::recomputeTables(const std::vector<int>& landmarkIndices) {
+    if (landmarkIndices.empty()) return;
+
+    int threadCount = std::min<int>(landmarkIndices.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([this, t, threadCount, &landmarkIndices] {
+            for (std::size_t i = t; i < landmarkIndices.size(); i += threadCount) 
+                computeTable(landmarkIndices[i]);
+        });
+    }
+
+    for (std::thread& worker : workers) 
+        worker.join();
+}
+
+// True if the reopened node connects to cells this landmark already reaches, i.e. it
+// may now lie on a shorter route from the landmark.
+bool LandmarkHeuristic::shortensPaths(const Table& table, const Node& node) const {
+    for (const Node& neighbor : grid.getNeighbors(node)) 
+        if (table.steps[index(neighbor)] != UNREACHABLE) 
+            return true;
+
+    return false;
+}
+
+bool LandmarkHeuristic::wasWalkable(const Table& table, int cell) {
+    return (table.walkable[cell / 64] >> (cell % 64)) & 1;
+}
+
+int LandmarkHeuristic::index(const Node& node) const {
+    return node.row * grid.getCols() + node.col;
+}
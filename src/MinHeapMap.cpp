@@ -2,6 +2,8 @@
 
 MinHeapMap::MinHeapMap() {}
 
+MinHeapMap::MinHeapMap(std::pmr::memory_resource* resource) : heap(resource), nodeToIndex(resource) {}
+
 MinHeapMap::MinHeapMap(const std::vector<HeapNode>& nodes) {
     for (const auto& node : nodes) // perhaps better to heapify
         insert(node.node, node.key);
@@ -32,6 +34,15 @@ const Key& MinHeapMap::topKey() const {
 bool MinHeapMap::contains(const Node& node) const {
     return nodeToIndex.find(node) != nodeToIndex.end();
 }
+
+std::vector<Node> MinHeapMap::nodes() const {
+    std::vector<Node> result;
+    result.reserve(heap.size());
+
+    for (const HeapNode& entry : heap) 
+        result.push_back(entry.node);
+    return result;
+}
     
 void MinHeapMap::insert(const Node& node, const Key& key) {
     if (contains(node))
@@ -0,0 +1,183 @@
+#include "PlannerTrace.h"
+#include "BinaryIO.h"
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    constexpr char MAGIC[4] = {'D', 'S', 'T', 'R'};
+    constexpr std::uint32_t VERSION = 1;
+
+    constexpr const char* TRUNCATED = "PlannerTrace: truncated trace file";
+    constexpr std::size_t NODE_BYTES = 2 * sizeof(std::int32_t) + 1; // as written by writeNode()
+
+    Node readNode(std::ifstream& in) {
+        std::int32_t row = 0;
+        std::int32_t col = 0;
+        std::uint8_t walkable = 0;
+        readRaw(in, &row, 1, TRUNCATED);
+        readRaw(in, &col, 1, TRUNCATED);
+        readRaw(in, &walkable, 1, TRUNCATED);
+        return Node(row, col, walkable != 0);
+    }
+}
+
+PlannerTrace PlannerTrace::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("PlannerTrace: cannot open " + path);
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::int32_t rows = 0;
+    std::int32_t cols = 0;
+
+    readRaw(in, magic, 4, TRUNCATED);
+    if (std::memcmp(magic, MAGIC, 4) != 0) throw std::runtime_error("PlannerTrace: not a DSTR file");
+    readRaw(in, &version, 1, TRUNCATED);
+    if (version != VERSION) throw std::runtime_error("PlannerTrace: unsupported DSTR version");
+    readRaw(in, &rows, 1, TRUNCATED);
+    readRaw(in, &cols, 1, TRUNCATED);
+    if (rows < 0 || cols < 0) throw std::runtime_error("PlannerTrace: corrupt header");
+
+    PlannerTrace trace;
+    trace.rows = rows;
+    trace.cols = cols;
+
+    // Initial grid, one bit per cell.
+    std::size_t cells = static_cast<std::size_t>(rows) * cols;
+    if ((cells + 7) / 8 > remainingBytes(in)) throw std::runtime_error("PlannerTrace: grid size exceeds the file size");
+    std::vector<std::uint8_t> bits((cells + 7) / 8);
+    readRaw(in, bits.data(), bits.size(), TRUNCATED);
+    trace.walkable.resize(cells);
+    for (std::size_t cell = 0; cell < cells; cell++)
+        trace.walkable[cell] = (bits[cell / 8] >> (cell % 8)) & 1;
+
+    std::uint8_t type = 0;
+    while (in.read(reinterpret_cast<char*>(&type), 1)) {
+        TraceEvent event;
+        event.type = static_cast<TraceEvent::Type>(type);
+
+        switch (event.type) {
+        case TraceEvent::Type::SetWalkable:
+            event.node = readNode(in);
+            break;
+        case TraceEvent::Type::FindPath:
+            event.node = readNode(in);
+            event.goal = readNode(in);
+            break;
+        case TraceEvent::Type::Notify: {
+            event.node = readNode(in);
+            std::uint32_t count = 0;
+            readRaw(in, &count, 1, TRUNCATED);
+            if (count > remainingBytes(in) / NODE_BYTES) throw std::runtime_error("PlannerTrace: change count exceeds the file size");
+            event.changes.reserve(count);
+            for (std::uint32_t i = 0; i < count; i++)
+                event.changes.push_back(readNode(in));
+            break;
+        }
+        default:
+            throw std::runtime_error("PlannerTrace: unknown event type");
+        }
+
+        trace.events.push_back(std::move(event));
+    }
+
+    return trace;
+}
+
+TraceRecorder::TraceRecorder(const std::string& path, Grid& grid, DStarLite& planner)
+    : out(path, std::ios::binary | std::ios::trunc), grid(grid), planner(planner) {
+    if (!out) throw std::runtime_error("PlannerTrace: cannot write " + path);
+
+    std::int32_t rows = grid.getRows();
+    std::int32_t cols = grid.getCols();
+    writeRaw(out, MAGIC, 4);
+    writeRaw(out, &VERSION, 1);
+    writeRaw(out, &rows, 1);
+    writeRaw(out, &cols, 1);
+
+    std::size_t cells = static_cast<std::size_t>(rows) * cols;
+    std::vector<std::uint8_t> bits((cells + 7) / 8, 0);
+    for (std::size_t cell = 0; cell < cells; cell++)
+        if (grid.isWalkable(Node(static_cast<int>(cell / cols), static_cast<int>(cell % cols))))
+            bits[cell / 8] |= static_cast<std::uint8_t>(1u << (cell % 8));
+    writeRaw(out, bits.data(), bits.size());
+}
+
+void TraceRecorder::setWalkable(const Node& node, bool walkable) {
+    std::uint8_t type = static_cast<std::uint8_t>(TraceEvent::Type::SetWalkable);
+    writeRaw(out, &type, 1);
+    writeNode(Node(node.row, node.col, walkable));
+
+    grid.setWalkable(node, walkable);
+}
+
+std::vector<Node> TraceRecorder::findPath(const Node& start, const Node& goal) {
+    std::uint8_t type = static_cast<std::uint8_t>(TraceEvent::Type::FindPath);
+    writeRaw(out, &type, 1);
+    writeNode(start);
+    writeNode(goal);
+
+    grid.updateConnectivity();
+    return planner.findPath(start, goal);
+}
+
+std::vector<Node> TraceRecorder::notifyEnvironmentChanges(const Node& agentNode, const std::vector<Node>& updatedNodes) {
+    std::uint8_t type = static_cast<std::uint8_t>(TraceEvent::Type::Notify);
+    std::uint32_t count = static_cast<std::uint32_t>(updatedNodes.size());
+    writeRaw(out, &type, 1);
+    writeNode(agentNode);
+    writeRaw(out, &count, 1);
+    for (const Node& node : updatedNodes)
+        writeNode(node);
+
+    grid.updateConnectivity();
+    return planner.notifyEnvironmentChanges(agentNode, updatedNodes);
+}
+
+void TraceRecorder::flush() {
+    out.flush();
+}
+
+void TraceRecorder::writeNode(const Node& node) {
+    std::int32_t row = node.row;
+    std::int32_t col = node.col;
+    std::uint8_t walkable = node.walkable ? 1 : 0;
+    writeRaw(out, &row, 1);
+    writeRaw(out, &col, 1);
+    writeRaw(out, &walkable, 1);
+}
+
+TraceReplayer::TraceReplayer(const PlannerTrace& trace) : trace(trace) {}
+
+std::vector<ReplayCall> TraceReplayer::run(const std::function<void(Grid&, DStarLite&)>& configure, SearchArena* arena) const {
+    using Clock = std::chrono::steady_clock;
+
+    Grid grid(trace.rows, trace.cols);
+    for (int cell = 0; cell < trace.rows * trace.cols; cell++)
+        if (!trace.walkable[cell]) grid.setWalkable(Node(cell / trace.cols, cell % trace.cols), false);
+
+    DStarLite planner(grid, arena);
+    if (configure) configure(grid, planner);
+
+    std::vector<ReplayCall> calls;
+    for (const TraceEvent& event : trace.events) {
+        if (event.type == TraceEvent::Type::SetWalkable) {
+            grid.setWalkable(event.node, event.node.walkable);
+            continue;
+        }
+
+        grid.updateConnectivity();
+        long long expansions = planner.stats().expansions;
+        auto begin = Clock::now();
+        std::vector<Node> path = event.type == TraceEvent::Type::FindPath
+            ? planner.findPath(event.node, event.goal)
+            : planner.notifyEnvironmentChanges(event.node, event.changes);
+        double micros = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+
+        calls.push_back(ReplayCall{event.type, micros, planner.stats().expansions - expansions, planner.stateSize(),
+                                   arena != nullptr ? arena->used() : 0, path.size()});
+    }
+
+    return calls;
+}
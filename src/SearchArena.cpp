@@ -0,0 +1,152 @@
+#include "SearchArena.h"
+#include <algorithm>
+#include <cstdint>
+
+SearchArena::SearchArena(std::size_t initialCapacity, std::pmr::memory_resource* upstream) 
+    : upstream(upstream), current(0), offset(0), usedBytes(0), allocations(0) {
+    std::fill(freeLists, freeLists + SIZE_CLASSES, nullptr);
+    std::fill(largeLists, largeLists + LARGE_CLASSES, nullptr);
+    addChunk(std::max<std::size_t>(initialCapacity, GRANULE));
+}
+
+SearchArena::~SearchArena() {
+    for (const Chunk& chunk : chunks) 
+        upstream->deallocate(chunk.data, chunk.size, alignof(std::max_align_t));
+}
+
+void SearchArena::reset() {
+    // A search that spilled into several chunks gets one chunk of the combined size,
+    // so the next search of the same size bumps through contiguous memory.
+    if (chunks.size() > 1) {
+        std::size_t total = capacity();
+
+        for (const Chunk& chunk : chunks) 
+            upstream->deallocate(chunk.data, chunk.size, alignof(std::max_align_t));
+
+        chunks.clear();
+        addChunk(total);
+    }
+
+    current = 0;
+    offset = 0;
+    usedBytes = 0;
+    std::fill(freeLists, freeLists + SIZE_CLASSES, nullptr);
+    std::fill(largeLists, largeLists + LARGE_CLASSES, nullptr);
+}
+
+std::size_t SearchArena::capacity() const {
+    std::size_t total = 0;
+
+    for (const Chunk& chunk : chunks) 
+        total += chunk.size;
+
+    return total;
+}
+
+std::size_t SearchArena::used() const {
+    return usedBytes;
+}
+
+std::size_t SearchArena::upstreamAllocations() const {
+    return allocations;
+}
+
+void* SearchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    int cls = sizeClass(bytes, alignment);
+
+    if (cls >= 0 && freeLists[cls] != nullptr) {
+        FreeBlock* block = freeLists[cls];
+        freeLists[cls] = block->next;
+        return block;
+    }
+
+    if (cls >= 0) {
+        // Small blocks are rounded up to their class so they can be recycled later.
+        std::size_t size = (cls + 1) * GRANULE;
+        usedBytes += size;
+        return bump(size, std::max(alignment, GRANULE));
+    }
+
+    int large = largeClass(bytes, alignment);
+    if (large < 0) {
+        usedBytes += bytes;
+        return bump(bytes, alignment);
+    }
+
+    if (largeLists[large] != nullptr) {
+        FreeBlock* block = largeLists[large];
+        largeLists[large] = block->next;
+        return block;
+    }
+
+    std::size_t size = std::size_t{1} << large;
+    usedBytes += size;
+    return bump(size, std::max(alignment, GRANULE));
+}
+
+void SearchArena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    int cls = sizeClass(bytes, alignment);
+    FreeBlock** list = nullptr;
+
+    if (cls >= 0) {
+        list = &freeLists[cls];
+    } else {
+        int large = largeClass(bytes, alignment);
+        if (large < 0) // over-aligned blocks are only reclaimed by reset()
+            return;
+        list = &largeLists[large];
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = *list;
+    *list = block;
+}
+
+bool SearchArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void* SearchArena::bump(std::size_t bytes, std::size_t alignment) {
+    while (true) {
+        Chunk& chunk = chunks[current];
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunk.data);
+        std::size_t aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+
+        if (aligned + bytes <= chunk.size) {
+            offset = aligned + bytes;
+            return chunk.data + aligned;
+        }
+
+        if (current + 1 == chunks.size()) 
+            addChunk(bytes + alignment);
+
+        current++;
+        offset = 0;
+    }
+}
+
+void SearchArena::addChunk(std::size_t minBytes) {
+    std::size_t size = chunks.empty() ? minBytes : std::max(minBytes, chunks.back().size * 2);
+    char* data = static_cast<char*>(upstream->allocate(size, alignof(std::max_align_t)));
+
+    chunks.push_back(Chunk{data, size});
+    allocations++;
+}
+
+int SearchArena::sizeClass(std::size_t bytes, std::size_t alignment) {
+    if (bytes == 0 || bytes > GRANULE * SIZE_CLASSES || alignment > GRANULE) 
+        return -1;
+
+    return static_cast<int>((bytes + GRANULE - 1) / GRANULE) - 1;
+}
+
+// Smallest k with 2^k >= bytes, for blocks above the small classes; -1 if not recyclable.
+int SearchArena::largeClass(std::size_t bytes, std::size_t alignment) {
+    if (bytes <= GRANULE * SIZE_CLASSES || alignment > GRANULE) 
+        return -1;
+
+    int k = 0;
+    while (k + 1 < static_cast<int>(LARGE_CLASSES) && (std::size_t{1} << k) < bytes) 
+        k++;
+    return (std::size_t{1} << k) >= bytes ? k : -1;
+}
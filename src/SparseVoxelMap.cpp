@@ -0,0 +1,130 @@
+#include "SparseVoxelMap.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    constexpr int FIELD_BITS = 21;
+    constexpr std::uint64_t FIELD_MASK = (1ULL << FIELD_BITS) - 1;
+
+    // Sign-extends a 21-bit brick coordinate.
+    int unpackField(std::uint64_t key, int shift) {
+        std::uint64_t field = (key >> shift) & FIELD_MASK;
+        return static_cast<int>(static_cast<std::int64_t>(field << (64 - FIELD_BITS)) >> (64 - FIELD_BITS));
+    }
+}
+
+std::uint64_t SparseVoxelMap::brickKey(int row, int col, int layer) {
+    // Arithmetic shifts floor negative coordinates onto their brick.
+    std::uint64_t r = static_cast<std::uint64_t>(row >> BRICK_BITS) & FIELD_MASK;
+    std::uint64_t c = static_cast<std::uint64_t>(col >> BRICK_BITS) & FIELD_MASK;
+    std::uint64_t l = static_cast<std::uint64_t>(layer >> BRICK_BITS) & FIELD_MASK;
+    return (r << (2 * FIELD_BITS)) | (c << FIELD_BITS) | l;
+}
+
+int SparseVoxelMap::bitIndex(int row, int col, int layer) {
+    constexpr int mask = BRICK_SIZE - 1;
+    return ((layer & mask) << (2 * BRICK_BITS)) | ((row & mask) << BRICK_BITS) | (col & mask);
+}
+
+bool SparseVoxelMap::setBit(Brick& brick, int bit, bool occupied) {
+    std::uint64_t& word = brick.bits[bit >> 6];
+    std::uint64_t mask = 1ULL << (bit & 63);
+
+    if (((word & mask) != 0) == occupied) return false;
+
+    word ^= mask;
+    brick.occupied += occupied ? 1 : -1;
+    occupiedVoxels += occupied ? 1 : -1;
+    return true;
+}
+
+bool SparseVoxelMap::isOccupied(int row, int col, int layer) const {
+    auto it = bricks.find(brickKey(row, col, layer));
+    if (it == bricks.end()) return false;
+
+    int bit = bitIndex(row, col, layer);
+    return (it->second.bits[bit >> 6] >> (bit & 63)) & 1ULL;
+}
+
+bool SparseVoxelMap::setOccupied(int row, int col, int layer, bool occupied) {
+    std::uint64_t key = brickKey(row, col, layer);
+    auto it = bricks.find(key);
+
+    if (it == bricks.end()) {
+        if (!occupied) return false;
+        it = bricks.emplace(key, Brick()).first;
+    }
+
+    bool changed = setBit(it->second, bitIndex(row, col, layer), occupied);
+    if (it->second.occupied == 0) bricks.erase(it);
+    return changed;
+}
+
+std::vector<Node> SparseVoxelMap::insertPoints(const std::vector<Point>& points, double voxelSize) {
+    if (!(voxelSize > 0.0)) throw std::runtime_error("SparseVoxelMap: voxel size must be positive");
+
+    // Sorting by brick visits each brick once however the cloud is ordered.
+    std::vector<std::pair<std::uint64_t, int>> hits;
+    hits.reserve(points.size());
+
+    for (const Point& p : points) {
+        int row = static_cast<int>(std::floor(p.y / voxelSize));
+        int col = static_cast<int>(std::floor(p.x / voxelSize));
+        int layer = static_cast<int>(std::floor(p.z / voxelSize));
+        hits.emplace_back(brickKey(row, col, layer), bitIndex(row, col, layer));
+    }
+
+    std::sort(hits.begin(), hits.end());
+    hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+
+    std::vector<Node> changed;
+    Brick* brick = nullptr;
+    std::uint64_t current = 0;
+
+    for (const auto& [key, bit] : hits) {
+        if (brick == nullptr || key != current) {
+            brick = &bricks[key];
+            current = key;
+        }
+
+        if (setBit(*brick, bit, true)) {
+            int row = unpackField(key, 2 * FIELD_BITS) * BRICK_SIZE + ((bit >> BRICK_BITS) & (BRICK_SIZE - 1));
+            int col = unpackField(key, FIELD_BITS) * BRICK_SIZE + (bit & (BRICK_SIZE - 1));
+            int layer = unpackField(key, 0) * BRICK_SIZE + (bit >> (2 * BRICK_BITS));
+            changed.emplace_back(row, col, layer, false);
+        }
+    }
+
+    return changed;
+}
+
+std::vector<Node> SparseVoxelMap::apply(const std::vector<Node>& voxels) {
+    std::vector<Node> changed;
+
+    for (const Node& voxel : voxels)
+        if (setOccupied(voxel.row, voxel.col, voxel.layer, !voxel.walkable))
+            changed.push_back(voxel);
+
+    return changed;
+}
+
+void SparseVoxelMap::clear() {
+    bricks.clear();
+    occupiedVoxels = 0;
+}
+
+std::size_t SparseVoxelMap::brickCount() const {
+    return bricks.size();
+}
+
+std::size_t SparseVoxelMap::occupiedCount() const {
+    return occupiedVoxels;
+}
+
+std::size_t SparseVoxelMap::memoryBytes() const {
+    // Node-based hash map: one allocation per brick plus the bucket array.
+    std::size_t perBrick = sizeof(std::uint64_t) + sizeof(Brick) + 2 * sizeof(void*);
+    return sizeof(*this) + bricks.size() * perBrick + bricks.bucket_count() * sizeof(void*);
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include "IGraph.h"
+#include <vector>
+
+// Helpers shared by the planner test suites.
+
+// Sum of the edge costs along `path`; 0 for paths of fewer than two nodes.
+inline double pathCost(const IGraph& graph, const std::vector<Node>& path) {
+    double cost = 0.0;
+    for (std::size_t i = 1; i < path.size(); i++) 
+        cost += graph.getEdgeCost(path[i - 1], path[i]);
+    return cost;
+}
@@ -0,0 +1,99 @@
+#include "AsyncDStarLite.h"
+#include "Grid.h"
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+
+class AsyncDStarLiteTest : public ::testing::Test {
+protected:
+    Grid grid{5, 5};
+
+    // Polls until the planner has published at least `version` paths.
+    static bool waitForVersion(const AsyncDStarLite& planner, std::uint64_t version) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+        while (planner.pathVersion() < version) {
+            if (std::chrono::steady_clock::now() > deadline) 
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return true;
+    }
+};
+
+TEST_F(AsyncDStarLiteTest, InitialPathPublished) {
+    AsyncDStarLite planner(grid);
+    EXPECT_TRUE(planner.latestPath()->empty());
+
+    planner.start(Node(0, 0), Node(4, 4));
+    ASSERT_TRUE(waitForVersion(planner, 1));
+
+    std::vector<Node> correctPath = { Node(0, 0), Node(1, 1), Node(2, 2), Node(3, 3), Node(4, 4) };
+    EXPECT_EQ(correctPath, *planner.latestPath());
+}
+
+TEST_F(AsyncDStarLiteTest, UpdateRepublishesPath) {
+    /*
+        S 0 0 0 0  -> 0 0 0 0 0
+        0 + 0 0 0	 0 S + 0 0 
+        0 0 + 0 0	 0 0 X + 0 
+        0 0 0 + 0     0 0 0 0 + 
+        0 0 0 0 E     0 0 0 0 E
+    */
+    AsyncDStarLite planner(grid);
+    planner.start(Node(0, 0), Node(4, 4));
+    ASSERT_TRUE(waitForVersion(planner, 1));
+
+    std::shared_ptr<const std::vector<Node>> oldPath = planner.latestPath();
+
+    EXPECT_TRUE(planner.pushUpdate(Node(1, 1), { Node(2, 2, false) }));
+    ASSERT_TRUE(waitForVersion(planner, 2));
+    planner.stop();
+
+    std::vector<Node> correctPath = { Node(1, 1), Node(1, 2), Node(2, 3), Node(3, 4), Node(4, 4) };
+    EXPECT_EQ(correctPath, *planner.latestPath());
+    EXPECT_FALSE(grid.isWalkable(Node(2, 2)));
+
+    // A reader's snapshot is never modified by later publications.
+    EXPECT_EQ(oldPath->size(), 5);
+    EXPECT_EQ(oldPath->front(), Node(0, 0));
+}
+
+TEST_F(AsyncDStarLiteTest, UpdatesCoalesce) {
+    AsyncDStarLite planner(grid);
+
+    // Queued before the initial plan finishes, so all of them land in a single replan.
+    // Blocking and then reopening a cell nets out to no obstacle.
+    for (int i = 0; i < 50; i++) {
+        EXPECT_TRUE(planner.pushUpdate(Node(0, 0), { Node(2, 2, false) }));
+        EXPECT_TRUE(planner.pushUpdate(Node(0, 0), { Node(2, 2, true) }));
+    }
+
+    planner.start(Node(0, 0), Node(4, 4));
+    ASSERT_TRUE(waitForVersion(planner, 2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    planner.stop();
+
+    EXPECT_EQ(planner.pathVersion(), 2);
+    EXPECT_TRUE(grid.isWalkable(Node(2, 2)));
+
+    std::vector<Node> correctPath = { Node(0, 0), Node(1, 1), Node(2, 2), Node(3, 3), Node(4, 4) };
+    EXPECT_EQ(correctPath, *planner.latestPath());
+}
+
+TEST_F(AsyncDStarLiteTest, IdlePlannerWakesForEveryUpdate) {
+    AsyncDStarLite planner(grid);
+    planner.start(Node(0, 0), Node(4, 4));
+    ASSERT_TRUE(waitForVersion(planner, 1));
+
+    // The planner only sleeps between updates, so a lost wake-up would stall a round.
+    for (std::uint64_t round = 0; round < 200; round++) {
+        bool walkable = round % 2 == 1;
+        ASSERT_TRUE(planner.pushUpdate(Node(0, 0), { Node(2, 2, walkable) }));
+        ASSERT_TRUE(waitForVersion(planner, round + 2)) << round;
+    }
+    planner.stop();
+
+    EXPECT_TRUE(grid.isWalkable(Node(2, 2)));
+}
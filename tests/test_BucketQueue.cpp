@@ -0,0 +1,102 @@
+#include "BucketQueue.h"
+#include "MinHeapMap.h"
+#include <random>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+class BucketQueueTest : public ::testing::Test {
+protected:
+    BucketQueue queue;
+    Node n1{1, 1}, n2{2, 2}, n3{3, 3}, n4{4, 4};
+};
+
+TEST_F(BucketQueueTest, PackKeepsKeyOrder) {
+    EXPECT_LT(BucketQueue::pack(Key(3, 9)), BucketQueue::pack(Key(4, 0)));
+    EXPECT_LT(BucketQueue::pack(Key(4, 1)), BucketQueue::pack(Key(4, 2)));
+
+    Key key = BucketQueue::unpack(BucketQueue::pack(Key(123456, 789)));
+    EXPECT_EQ(key.k1, 123456.0);
+    EXPECT_EQ(key.k2, 789.0);
+
+    EXPECT_THROW(BucketQueue::pack(Key(1.5, 0)), std::runtime_error);
+    EXPECT_THROW(BucketQueue::pack(Key(-1, 0)), std::runtime_error);
+    EXPECT_THROW(BucketQueue::pack(Key(IGraph::INF_COST, 0)), std::runtime_error);
+}
+
+TEST_F(BucketQueueTest, PopsInKeyOrderWithK2Tiebreak) {
+    queue.insert(n1, Key(20, 5));
+    queue.insert(n2, Key(10, 7));
+    queue.insert(n3, Key(10, 3));
+    queue.insert(n4, Key(5, 1)); // below the first bucket
+
+    EXPECT_EQ(queue.count(), 4);
+    EXPECT_EQ(queue.pop(), n4);
+    EXPECT_EQ(queue.pop(), n3);
+    EXPECT_EQ(queue.topKey().k2, 7.0);
+    EXPECT_EQ(queue.pop(), n2);
+    EXPECT_EQ(queue.pop(), n1);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_THROW(queue.pop(), std::runtime_error);
+}
+
+TEST_F(BucketQueueTest, UpdateAndRemoveSkipStaleEntries) {
+    queue.insert(n1, Key(10, 0));
+    queue.insert(n2, Key(11, 0));
+    queue.insert(n3, Key(12, 0));
+
+    queue.update(n1, Key(30, 0));
+    EXPECT_EQ(queue.top(), n2);
+
+    queue.remove(n2);
+    EXPECT_FALSE(queue.contains(n2));
+    EXPECT_EQ(queue.top(), n3);
+
+    queue.update(n3, Key(2, 0));
+    EXPECT_EQ(queue.topKey().k1, 2.0);
+    EXPECT_EQ(queue.pop(), n3);
+    EXPECT_EQ(queue.pop(), n1);
+    EXPECT_TRUE(queue.isEmpty());
+
+    EXPECT_THROW(queue.remove(n1), std::runtime_error);
+    EXPECT_THROW(queue.update(n1, Key(1, 0)), std::runtime_error);
+    queue.insert(n1, Key(1, 0));
+    EXPECT_THROW(queue.insert(n1, Key(1, 0)), std::runtime_error);
+}
+
+TEST_F(BucketQueueTest, MatchesMinHeapMapOnRandomOperations) {
+    MinHeapMap heap;
+    std::mt19937 rng(5);
+
+    for (int step = 0; step < 20000; step++) {
+        Node node(rng() % 40, 0);
+        Key key(rng() % 500 + step / 10, rng() % 50); // drifting keys, as km does
+
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            if (heap.contains(node)) {
+                heap.update(node, key);
+                queue.update(node, key);
+            } else {
+                heap.insert(node, key);
+                queue.insert(node, key);
+            }
+            break;
+        case 2:
+            if (heap.contains(node)) {
+                heap.remove(node);
+                queue.remove(node);
+            }
+            break;
+        default:
+            if (!heap.isEmpty()) {
+                Key expected = heap.topKey();
+                EXPECT_EQ(queue.topKey().k1, expected.k1);
+                EXPECT_EQ(queue.topKey().k2, expected.k2);
+                queue.remove(heap.pop());
+            }
+        }
+
+        ASSERT_EQ(queue.count(), heap.count());
+    }
+}
@@ -0,0 +1,149 @@
+#include "CSRGraph.h"
+#include "DStarLite.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+class CSRGraphTest : public ::testing::Test {
+protected:
+    /*
+        0 -> 1 -> 2 -> 3      (cost 1 each, one-way)
+        0 -------------> 3    (cost 10)
+        3 -> 0                (cost 1)
+    */
+    CSRGraph graph{4, {{0, 1, 1.0}, {1, 2, 1.0}, {2, 3, 1.0}, {0, 3, 10.0}, {3, 0, 1.0}}};
+
+    std::string tempPath(const std::string& name) const {
+        return ::testing::TempDir() + name;
+    }
+};
+
+TEST_F(CSRGraphTest, DirectedAdjacency) {
+    EXPECT_EQ(graph.nodeCount(), 4);
+    EXPECT_EQ(graph.edgeCount(), 5);
+
+    std::vector<Node> out = graph.getNeighbors(CSRGraph::node(0));
+    std::vector<Node> in = graph.getPredecessors(CSRGraph::node(0));
+
+    EXPECT_EQ(out, (std::vector<Node>{ CSRGraph::node(1), CSRGraph::node(3) }));
+    EXPECT_EQ(in, (std::vector<Node>{ CSRGraph::node(3) }));
+    EXPECT_DOUBLE_EQ(graph.getEdgeCost(CSRGraph::node(0), CSRGraph::node(1)), 1.0);
+    EXPECT_EQ(graph.getEdgeCost(CSRGraph::node(1), CSRGraph::node(0)), IGraph::INF_COST);
+}
+
+TEST_F(CSRGraphTest, EdgeCostMutation) {
+    std::int64_t edge = graph.findEdge(1, 2);
+    ASSERT_GE(edge, 0);
+    EXPECT_EQ(graph.edgeSource(edge), 1);
+    EXPECT_EQ(graph.edgeTarget(edge), 2);
+    EXPECT_EQ(graph.findEdge(2, 1), -1);
+
+    graph.setEdgeCost(edge, IGraph::INF_COST);
+
+    EXPECT_TRUE(graph.getNeighbors(CSRGraph::node(1)).empty());
+    EXPECT_TRUE(graph.getPredecessors(CSRGraph::node(2)).empty());
+}
+
+TEST_F(CSRGraphTest, PlannerFollowsEdgeDirection) {
+    DStarLite dstar(graph);
+
+    std::vector<Node> correctPath = { CSRGraph::node(0), CSRGraph::node(1), CSRGraph::node(2), CSRGraph::node(3) };
+    EXPECT_EQ(dstar.findPath(CSRGraph::node(0), CSRGraph::node(3)), correctPath);
+
+    std::vector<Node> backPath = { CSRGraph::node(3), CSRGraph::node(0) };
+    EXPECT_EQ(dstar.findPath(CSRGraph::node(3), CSRGraph::node(0)), backPath);
+}
+
+TEST_F(CSRGraphTest, ReplanAfterEdgeClosure) {
+    DStarLite dstar(graph);
+    dstar.findPath(CSRGraph::node(0), CSRGraph::node(3));
+
+    // Closing 1 -> 2 changes the outgoing edges of node 1, so node 1 is reported.
+    graph.setEdgeCost(graph.findEdge(1, 2), IGraph::INF_COST);
+    std::vector<Node> path = dstar.notifyEnvironmentChanges(CSRGraph::node(0), { CSRGraph::node(1) });
+
+    std::vector<Node> correctPath = { CSRGraph::node(0), CSRGraph::node(3) };
+    EXPECT_EQ(path, correctPath);
+}
+
+TEST_F(CSRGraphTest, BinaryRoundTrip) {
+    graph.setCoordinates({0.0, 1.0, 2.0, 3.0}, {0.0, 0.0, 0.0, 0.0}, 0.5);
+    graph.setWalkable(CSRGraph::node(2), false);
+
+    std::string path = tempPath("roundtrip.csrg");
+    graph.saveBinary(path);
+    CSRGraph loaded = CSRGraph::loadBinary(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(loaded.nodeCount(), graph.nodeCount());
+    EXPECT_EQ(loaded.edgeCount(), graph.edgeCount());
+    EXPECT_FALSE(loaded.isWalkable(CSRGraph::node(2)));
+    EXPECT_EQ(loaded.getPredecessors(CSRGraph::node(0)), graph.getPredecessors(CSRGraph::node(0)));
+    EXPECT_DOUBLE_EQ(loaded.getEdgeCost(CSRGraph::node(0), CSRGraph::node(3)), 10.0);
+    EXPECT_DOUBLE_EQ(loaded.getEuclideanDistance(CSRGraph::node(0), CSRGraph::node(3)), 1.5);
+}
+
+TEST_F(CSRGraphTest, RejectsForeignBinary) {
+    std::string path = tempPath("foreign.csrg");
+    std::ofstream(path, std::ios::binary) << "not a graph";
+
+    EXPECT_THROW(CSRGraph::loadBinary(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_F(CSRGraphTest, UnsortedAndParallelEdges) {
+    CSRGraph mixed(4, {{0, 3, 2.0}, {0, 1, 1.0}, {0, 3, 5.0}, {0, 2, 1.0}, {0, 3, 4.0}});
+
+    EXPECT_EQ(mixed.getNeighbors(CSRGraph::node(0)), 
+              (std::vector<Node>{ CSRGraph::node(1), CSRGraph::node(2), CSRGraph::node(3), CSRGraph::node(3), CSRGraph::node(3) }));
+    EXPECT_DOUBLE_EQ(mixed.getEdgeCost(CSRGraph::node(0), CSRGraph::node(3)), 2.0);
+
+    // Raising the cheapest parallel edge hands the lookup to the next cheapest.
+    mixed.setEdgeCost(mixed.findEdge(0, 3), 9.0);
+    EXPECT_DOUBLE_EQ(mixed.getEdgeCost(CSRGraph::node(0), CSRGraph::node(3)), 4.0);
+    EXPECT_EQ(mixed.findEdge(0, 0), -1);
+}
+
+TEST_F(CSRGraphTest, RejectsCountsLargerThanTheFile) {
+    std::string binPath = tempPath("huge.csrg");
+    {
+        std::ofstream out(binPath, std::ios::binary);
+        std::uint32_t version = 1;
+        std::int32_t n = 4;
+        std::int64_t m = std::int64_t{1} << 40;
+        std::uint8_t hasCoordinates = 0;
+        double scale = 1.0;
+        out.write("CSRG", 4);
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        out.write(reinterpret_cast<const char*>(&m), sizeof(m));
+        out.write(reinterpret_cast<const char*>(&hasCoordinates), sizeof(hasCoordinates));
+        out.write(reinterpret_cast<const char*>(&scale), sizeof(scale));
+    }
+    EXPECT_THROW(CSRGraph::loadBinary(binPath), std::runtime_error);
+    std::remove(binPath.c_str());
+
+    std::string grPath = tempPath("huge.gr");
+    std::ofstream(grPath) << "p sp 3 1000000000000\na 1 2 4\n";
+    EXPECT_THROW(CSRGraph::loadDimacs(grPath), std::runtime_error);
+    std::remove(grPath.c_str());
+}
+
+TEST_F(CSRGraphTest, LoadDimacs) {
+    std::string grPath = tempPath("tiny.gr");
+    std::string coPath = tempPath("tiny.co");
+    std::ofstream(grPath) << "c tiny\np sp 3 3\na 1 2 4\na 2 3 5\na 3 1 7\n";
+    std::ofstream(coPath) << "c tiny\np aux sp co 3\nv 1 0 0\nv 2 3 4\nv 3 6 8\n";
+
+    CSRGraph dimacs = CSRGraph::loadDimacs(grPath);
+    dimacs.loadDimacsCoordinates(coPath);
+    std::remove(grPath.c_str());
+    std::remove(coPath.c_str());
+
+    EXPECT_EQ(dimacs.nodeCount(), 3);
+    EXPECT_EQ(dimacs.edgeCount(), 3);
+    EXPECT_DOUBLE_EQ(dimacs.getEdgeCost(CSRGraph::node(1), CSRGraph::node(2)), 5.0);
+    EXPECT_DOUBLE_EQ(dimacs.getEuclideanDistance(CSRGraph::node(0), CSRGraph::node(2)), 10.0);
+}
@@ -0,0 +1,113 @@
+#include "ConnectedGrid.h"
+#include "DStarLite.h"
+#include "Grid.h"
+#include "TestUtils.h"
+#include <cmath>
+#include <random>
+#include <gtest/gtest.h>
+
+class ConnectedGridTest : public ::testing::Test {
+protected:
+    inline static constexpr double EPSILON = 1e-6;
+};
+
+TEST_F(ConnectedGridTest, NeighborCounts) {
+    Grid4 grid4(5, 5);
+    Grid8 grid8(5, 5);
+    Grid16 grid16(5, 5);
+
+    EXPECT_EQ(grid4.getNeighbors(Node(2, 2)).size(), 4);
+    EXPECT_EQ(grid8.getNeighbors(Node(2, 2)).size(), 8);
+    EXPECT_EQ(grid16.getNeighbors(Node(2, 2)).size(), 16);
+
+    EXPECT_EQ(grid4.getNeighbors(Node(0, 0)).size(), 2);
+    EXPECT_EQ(grid8.getNeighbors(Node(0, 0)).size(), 3);
+    EXPECT_EQ(grid16.getNeighbors(Node(0, 0)).size(), 5);
+}
+
+TEST_F(ConnectedGridTest, EdgeCosts) {
+    Grid4 grid4(5, 5);
+    Grid16 grid16(5, 5);
+
+    EXPECT_NEAR(grid4.getEdgeCost(Node(1, 1), Node(1, 2)), 1.0, EPSILON);
+    EXPECT_TRUE(std::isinf(grid4.getEdgeCost(Node(1, 1), Node(2, 2))));
+    EXPECT_NEAR(grid16.getEdgeCost(Node(1, 1), Node(2, 2)), std::sqrt(2), EPSILON);
+    EXPECT_NEAR(grid16.getEdgeCost(Node(1, 1), Node(3, 2)), std::sqrt(5), EPSILON);
+    EXPECT_TRUE(std::isinf(grid16.getEdgeCost(Node(1, 1), Node(3, 3))));
+
+    grid16.setWalkable(Node(3, 2), false);
+    EXPECT_TRUE(std::isinf(grid16.getEdgeCost(Node(1, 1), Node(3, 2))));
+}
+
+TEST_F(ConnectedGridTest, HeuristicsMatchConnectivity) {
+    Grid4 grid4(10, 10);
+    Grid8 grid8(10, 10);
+    Grid16 grid16(10, 10);
+
+    EXPECT_NEAR(grid4.getHeuristic(Node(0, 0), Node(3, 4)), 7.0, EPSILON);
+    EXPECT_NEAR(grid8.getHeuristic(Node(0, 0), Node(3, 4)), 1.0 + 3.0 * std::sqrt(2), EPSILON);
+    EXPECT_LE(grid16.getHeuristic(Node(0, 0), Node(3, 4)), 5.0 + EPSILON);
+    EXPECT_GE(grid16.getHeuristic(Node(0, 0), Node(3, 4)), 4.9);
+}
+
+TEST_F(ConnectedGridTest, Grid8MatchesGrid) {
+    Grid reference(20, 20);
+    Grid8 grid8(20, 20);
+
+    std::mt19937 rng(3);
+    for (int i = 0; i < 80; i++) {
+        Node node(rng() % 20, rng() % 20);
+        reference.setWalkable(node, false);
+        grid8.setWalkable(node, false);
+    }
+    reference.setWalkable(Node(0, 0), true);
+    reference.setWalkable(Node(19, 19), true);
+    grid8.setWalkable(Node(0, 0), true);
+    grid8.setWalkable(Node(19, 19), true);
+
+    DStarLite referencePlanner(reference);
+    DStarLite planner(grid8);
+
+    std::vector<Node> referencePath = referencePlanner.findPath(Node(0, 0), Node(19, 19));
+    std::vector<Node> path = planner.findPath(Node(0, 0), Node(19, 19));
+
+    ASSERT_FALSE(path.empty());
+    EXPECT_NEAR(pathCost(reference, referencePath), pathCost(grid8, path), EPSILON);
+}
+
+TEST_F(ConnectedGridTest, OctileExpandsLessThanEuclidean) {
+    Grid8 grid(30, 30);
+    for (int r = 0; r < 25; r++) 
+        grid.setWalkable(Node(r, 15), false);
+
+    EuclideanHeuristic euclidean(grid);
+    DStarLite euclideanPlanner(grid);
+    euclideanPlanner.setHeuristic(&euclidean);
+    DStarLite octilePlanner(grid);
+
+    std::vector<Node> euclideanPath = euclideanPlanner.findPath(Node(0, 0), Node(0, 29));
+    std::vector<Node> octilePath = octilePlanner.findPath(Node(0, 0), Node(0, 29));
+
+    EXPECT_NEAR(pathCost(grid, euclideanPath), pathCost(grid, octilePath), EPSILON);
+    EXPECT_LT(octilePlanner.stats().expansions, euclideanPlanner.stats().expansions);
+}
+
+TEST_F(ConnectedGridTest, Grid16UsesKnightMoves) {
+    Grid16 grid(5, 5);
+    DStarLite dstar(grid);
+
+    std::vector<Node> path = dstar.findPath(Node(0, 0), Node(2, 4));
+    EXPECT_NEAR(pathCost(grid, path), 2.0 * std::sqrt(5), EPSILON);
+}
+
+TEST_F(ConnectedGridTest, Grid4Replanning) {
+    Grid4 grid(5, 5);
+    DStarLite dstar(grid);
+
+    std::vector<Node> path = dstar.findPath(Node(0, 0), Node(0, 4));
+    EXPECT_NEAR(pathCost(grid, path), 4.0, EPSILON);
+
+    grid.setWalkable(Node(0, 2), false);
+    path = dstar.notifyEnvironmentChanges(Node(0, 0), { Node(0, 2) });
+    EXPECT_NEAR(pathCost(grid, path), 6.0, EPSILON);
+}
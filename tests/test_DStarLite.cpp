@@ -1,11 +1,24 @@
 #include "DStarLite.h"
 #include "Grid.h"
+#include "TestUtils.h"
 #include <vector>
+#include <algorithm>
+#include <random>
 #include <gtest/gtest.h>
 
 class DStarLiteTest : public ::testing::Test {
 protected:
     Grid grid{5, 5};
+
+    // Blocks size * size / density random cells, then reopens the corners used as agent and goal.
+    static void scatterObstacles(Grid& grid, std::mt19937& rng, int density) {
+        int size = grid.getRows();
+        for (int i = 0; i < size * size / density; i++) 
+            grid.setWalkable(Node(rng() % size, rng() % size), false);
+
+        grid.setWalkable(Node(0, 0), true);
+        grid.setWalkable(Node(size - 1, size - 1), true);
+    }
 };
 
 TEST_F(DStarLiteTest, SmallGrid) {
@@ -190,3 +203,433 @@ TEST_F(DStarLiteTest, ComplexTest) {
     std::vector<Node> actualPath = dstar.findPath(Node(0, 0), Node(4, 4));
     EXPECT_EQ(correctPath, actualPath);
 }
+
+// Many short random missions on the default octile grid, each replan checked against a fresh
+// search. Sums of sqrt(2) along equal-cost paths differ by rounding noise, which used to let the
+// open list and the start-key check disagree about ties and stop the search with a needed node
+// still queued.
+TEST_F(DStarLiteTest, RandomReplansMatchFreshSearch) {
+    for (int seed = 0; seed < 20; seed++) {
+        Grid small(16, 16);
+        std::mt19937 rng(seed);
+        scatterObstacles(small, rng, 5);
+
+        Node agent(0, 0);
+        Node goal(15, 15);
+
+        DStarLite dstar(small);
+        std::vector<Node> path = dstar.findPath(agent, goal);
+
+        for (int step = 0; step < 60 && path.size() > 1; step++) {
+            agent = path[1];
+
+            std::vector<Node> changes;
+            int count = 1 + rng() % 8;
+            for (int i = 0; i < count; i++) {
+                Node node(rng() % 16, rng() % 16);
+                if (node == agent || node == goal) continue;
+                small.setWalkable(node, !small.isWalkable(node));
+                changes.push_back(node);
+            }
+
+            path = dstar.notifyEnvironmentChanges(agent, changes);
+
+            DStarLite fresh(small);
+            std::vector<Node> expected = fresh.findPath(agent, goal);
+            ASSERT_EQ(expected.empty(), path.empty()) << "seed " << seed << ", step " << step;
+            if (path.empty()) break;
+
+            EXPECT_EQ(path.back(), goal) << "seed " << seed << ", step " << step;
+            EXPECT_NEAR(pathCost(small, expected), pathCost(small, path), 1e-6) << "seed " << seed << ", step " << step;
+        }
+    }
+}
+
+TEST_F(DStarLiteTest, ReplanExpandsStaleTiesBeforeStopping) {
+    /*
+        0 X 0 X 0 0  ->  0 X 0 X 0 0
+        0 + + + + 0      0 S 0 X + 0
+        S 0 0 0 X E      0 0 + + X E
+        X 0 X 0 0 X      X 0 X 0 X X
+    */
+    Grid small(4, 6);
+    for (const Node& wall : { Node(0, 1), Node(0, 3), Node(2, 4), Node(3, 0), Node(3, 2), Node(3, 5) })
+        small.setWalkable(wall, false);
+
+    DStarLite dstar(small);
+    dstar.findPath(Node(2, 0), Node(2, 5));
+
+    // (3, 3)'s g of 1 + sqrt(2) goes stale here: its rhs becomes 1 + 2 * sqrt(2). Its key ties
+    // the start's up to rounding noise, so the replan has to expand it before stopping. Through
+    // the stale g, (3, 3) would exactly tie (2, 3) as the step out of (2, 2) and detour the path
+    // at a cost of 2 + 2 * sqrt(2) more.
+    small.setWalkable(Node(1, 3), false);
+    small.setWalkable(Node(3, 4), false);
+    std::vector<Node> actualPath = dstar.notifyEnvironmentChanges(Node(1, 1), { Node(1, 3), Node(3, 4) });
+
+    DStarLite fresh(small);
+    std::vector<Node> freshPath = fresh.findPath(Node(1, 1), Node(2, 5));
+    EXPECT_NEAR(pathCost(small, freshPath), pathCost(small, actualPath), 1e-6);
+    EXPECT_EQ(std::find(actualPath.begin(), actualPath.end(), Node(3, 3)), actualPath.end());
+}
+
+TEST_F(DStarLiteTest, FocusedReplanDefersFarChanges) {
+    // A wall cell beside the diagonal opens far from the agent. It cannot shorten the path, so
+    // its repair waits in the deferred queue while the returned path is already optimal.
+    Grid big(20, 20);
+    Node gap(17, 18);
+    big.setWalkable(gap, false);
+
+    DStarLite focused(big);
+    DStarLite reference(big);
+    focused.setFocusRadius(3.0);
+
+    focused.findPath(Node(0, 0), Node(19, 19));
+    reference.findPath(Node(0, 0), Node(19, 19));
+
+    big.setWalkable(gap, true);
+    std::vector<Node> actualPath = focused.notifyEnvironmentChanges(Node(1, 1), { gap });
+    EXPECT_GT(focused.deferredCount(), 0);
+
+    DStarLite fresh(big);
+    std::vector<Node> freshPath = fresh.findPath(Node(1, 1), Node(19, 19));
+    ASSERT_FALSE(actualPath.empty());
+    EXPECT_EQ(actualPath.front(), Node(1, 1));
+    EXPECT_EQ(actualPath.back(), Node(19, 19));
+    EXPECT_NEAR(pathCost(big, freshPath), pathCost(big, actualPath), 1e-6);
+
+    std::vector<Node> correctPath = reference.notifyEnvironmentChanges(Node(1, 1), { gap });
+    actualPath = focused.resumeDeferred();
+
+    EXPECT_EQ(focused.deferredCount(), 0);
+    EXPECT_EQ(correctPath, actualPath);
+}
+
+TEST_F(DStarLiteTest, FocusedReplanRepairsFarChangesOnThePath) {
+    /*
+        S 0 0 0 0  -> 0 0 0 0 0
+        0 + 0 0 0     0 S + 0 0
+        0 0 + 0 0     0 0 0 + 0
+        0 0 0 + 0     0 0 0 X +
+        0 0 0 0 E     0 0 0 0 E
+        (X lies outside the window but on the path, so its repair cannot be deferred)
+    */
+    DStarLite focused(grid);
+    focused.setFocusRadius(1.0);
+    focused.findPath(Node(0, 0), Node(4, 4));
+
+    grid.setWalkable(Node(3, 3), false);
+    std::vector<Node> actualPath = focused.notifyEnvironmentChanges(Node(1, 1), { Node(3, 3) });
+
+    DStarLite fresh(grid);
+    std::vector<Node> freshPath = fresh.findPath(Node(1, 1), Node(4, 4));
+    ASSERT_FALSE(actualPath.empty());
+    EXPECT_EQ(actualPath.front(), Node(1, 1));
+    EXPECT_EQ(actualPath.back(), Node(4, 4));
+    EXPECT_EQ(std::find(actualPath.begin(), actualPath.end(), Node(3, 3)), actualPath.end());
+    EXPECT_NEAR(pathCost(grid, freshPath), pathCost(grid, actualPath), 1e-6);
+    EXPECT_EQ(focused.deferredCount(), 0);
+}
+
+TEST_F(DStarLiteTest, FocusedReplanNearChange) {
+    /*
+        S 0 0 0 0  -> 0 0 0 0 0
+        0 + 0 0 0     0 S + 0 0
+        0 0 + 0 0     0 0 X + 0
+        0 0 0 + 0     0 0 0 0 +
+        0 0 0 0 E     0 0 0 0 E
+        (any equal-cost detour around X is optimal)
+    */
+    DStarLite dstar(grid);
+    dstar.setFocusRadius(3.0);
+    dstar.findPath(Node(0, 0), Node(4, 4));
+
+    grid.setWalkable(Node(2, 2), false);
+    std::vector<Node> actualPath = dstar.notifyEnvironmentChanges(Node(1, 1), { Node(2, 2) });
+
+    ASSERT_EQ(actualPath.size(), 5);
+    EXPECT_EQ(actualPath.front(), Node(1, 1));
+    EXPECT_EQ(actualPath.back(), Node(4, 4));
+    EXPECT_EQ(std::find(actualPath.begin(), actualPath.end(), Node(2, 2)), actualPath.end());
+}
+
+TEST_F(DStarLiteTest, FocusedReplanSurvivesStaleCycles) {
+    /*
+        X X 0 S
+        E X + 0
+        + X + 0
+        0 + 0 0
+    */
+    Grid small(4, 4);
+    for (const Node& wall : { Node(0, 0), Node(0, 1), Node(1, 1), Node(2, 1) })
+        small.setWalkable(wall, false);
+
+    DStarLite dstar(small);
+    dstar.setFocusRadius(2.0);
+    dstar.findPath(Node(0, 3), Node(1, 0));
+
+    small.setWalkable(Node(3, 3), false);
+    dstar.notifyEnvironmentChanges(Node(1, 2), { Node(3, 3) });
+
+    // With part of this repair deferred, following g from (2, 2) runs in a circle. The walk
+    // has to stop at the repeat for the replan to notice and finish the repair.
+    small.setWalkable(Node(0, 1), true);
+    small.setWalkable(Node(3, 1), false);
+    std::vector<Node> actualPath = dstar.notifyEnvironmentChanges(Node(2, 2), { Node(0, 1), Node(3, 1) });
+
+    DStarLite fresh(small);
+    std::vector<Node> freshPath = fresh.findPath(Node(2, 2), Node(1, 0));
+    ASSERT_FALSE(actualPath.empty());
+    EXPECT_EQ(actualPath.back(), Node(1, 0));
+    EXPECT_NEAR(pathCost(small, freshPath), pathCost(small, actualPath), 1e-6);
+}
+
+// Deferred far-field repairs may cost optimality, but never more than the focus radius.
+TEST_F(DStarLiteTest, FocusedReplansStayWithinRadiusOfOptimal) {
+    const double radius = 1.0;
+    int deferredReplans = 0;
+
+    for (int seed = 0; seed < 20; seed++) {
+        Grid small(16, 16);
+        std::mt19937 rng(seed);
+        scatterObstacles(small, rng, 5);
+
+        Node agent(0, 0);
+        Node goal(15, 15);
+
+        DStarLite dstar(small);
+        dstar.setFocusRadius(radius);
+        std::vector<Node> path = dstar.findPath(agent, goal);
+
+        for (int step = 0; step < 60 && path.size() > 1; step++) {
+            agent = path[1];
+
+            std::vector<Node> changes;
+            int count = 1 + rng() % 8;
+            for (int i = 0; i < count; i++) {
+                Node node(rng() % 16, rng() % 16);
+                if (node == agent || node == goal) continue;
+                small.setWalkable(node, !small.isWalkable(node));
+                changes.push_back(node);
+            }
+
+            path = dstar.notifyEnvironmentChanges(agent, changes);
+            deferredReplans += dstar.deferredCount() > 0;
+
+            DStarLite fresh(small);
+            std::vector<Node> expected = fresh.findPath(agent, goal);
+            ASSERT_EQ(expected.empty(), path.empty()) << "seed " << seed << ", step " << step;
+            if (path.empty()) break;
+
+            EXPECT_EQ(path.front(), agent) << "seed " << seed << ", step " << step;
+            EXPECT_EQ(path.back(), goal) << "seed " << seed << ", step " << step;
+            EXPECT_LE(pathCost(small, path), pathCost(small, expected) + radius + 1e-6) << "seed " << seed << ", step " << step;
+        }
+    }
+
+    EXPECT_GT(deferredReplans, 0);
+}
+
+TEST_F(DStarLiteTest, MemoryBudgetKeepsStateBoundedAndPathsOptimal) {
+    Grid big(80, 80);
+    std::mt19937 rng(3);
+    scatterObstacles(big, rng, 6);
+
+    Node agent(0, 0);
+    Node goal(79, 79);
+
+    const std::size_t budget = 900;
+    DStarLite unbounded(big);
+    DStarLite bounded(big);
+    bounded.setMemoryBudget(budget);
+
+    std::vector<Node> correctPath = unbounded.findPath(agent, goal);
+    std::vector<Node> actualPath = bounded.findPath(agent, goal);
+    ASSERT_FALSE(correctPath.empty());
+    EXPECT_NEAR(pathCost(big, correctPath), pathCost(big, actualPath), 1e-6);
+
+    for (int step = 0; step < 60 && actualPath.size() > 1; step++) {
+        agent = actualPath[1];
+
+        std::vector<Node> changes;
+        for (int i = 0; i < 40; i++) {
+            Node node(rng() % 80, rng() % 80);
+            if (node == agent || node == goal) continue;
+            big.setWalkable(node, !big.isWalkable(node));
+            changes.push_back(node);
+        }
+
+        correctPath = unbounded.notifyEnvironmentChanges(agent, changes);
+        actualPath = bounded.notifyEnvironmentChanges(agent, changes);
+
+        ASSERT_EQ(correctPath.empty(), actualPath.empty());
+        EXPECT_NEAR(pathCost(big, correctPath), pathCost(big, actualPath), 1e-6);
+        EXPECT_LE(bounded.stateSize(), budget);
+    }
+
+    EXPECT_GT(bounded.stats().evictions, 0);
+    EXPECT_GT(unbounded.stateSize(), budget);
+}
+
+// A budget of a quarter of a small grid evicts on almost every replan, so most searches start
+// from a freshly trimmed state. Each replan is checked against a fresh search.
+TEST_F(DStarLiteTest, TightMemoryBudgetReplansMatchFreshSearch) {
+    for (int seed = 0; seed < 20; seed++) {
+        Grid small(16, 16);
+        std::mt19937 rng(seed);
+        scatterObstacles(small, rng, 5);
+
+        Node agent(0, 0);
+        Node goal(15, 15);
+
+        DStarLite dstar(small);
+        dstar.setMemoryBudget(64);
+        std::vector<Node> path = dstar.findPath(agent, goal);
+
+        for (int step = 0; step < 60 && path.size() > 1; step++) {
+            agent = path[1];
+
+            std::vector<Node> changes;
+            int count = 1 + rng() % 8;
+            for (int i = 0; i < count; i++) {
+                Node node(rng() % 16, rng() % 16);
+                if (node == agent || node == goal) continue;
+                small.setWalkable(node, !small.isWalkable(node));
+                changes.push_back(node);
+            }
+
+            path = dstar.notifyEnvironmentChanges(agent, changes);
+
+            DStarLite fresh(small);
+            std::vector<Node> expected = fresh.findPath(agent, goal);
+            ASSERT_EQ(expected.empty(), path.empty()) << "seed " << seed << ", step " << step;
+            if (path.empty()) break;
+
+            EXPECT_EQ(path.back(), goal) << "seed " << seed << ", step " << step;
+            EXPECT_NEAR(pathCost(small, expected), pathCost(small, path), 1e-6) << "seed " << seed << ", step " << step;
+        }
+
+        EXPECT_GT(dstar.stats().evictions, 0) << "seed " << seed;
+    }
+}
+
+TEST_F(DStarLiteTest, UnreachableGoalIsRejectedWithoutSearch) {
+    Grid big(100, 100);
+    for (int r = 0; r < 100; r++) big.setWalkable(Node(r, 50), false);
+    big.updateConnectivity();
+
+    DStarLite dstar(big);
+    EXPECT_TRUE(dstar.findPath(Node(0, 0), Node(99, 99)).empty());
+    EXPECT_EQ(dstar.stats().expansions, 0);
+
+    // Opening the wall later still finds the path from the seeded search.
+    Node gap(70, 50);
+    big.setWalkable(gap, true);
+    big.updateConnectivity();
+    std::vector<Node> path = dstar.notifyEnvironmentChanges(Node(0, 0), {gap});
+
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), Node(0, 0));
+    EXPECT_EQ(path.back(), Node(99, 99));
+    EXPECT_NE(std::find(path.begin(), path.end(), gap), path.end());
+}
+
+TEST_F(DStarLiteTest, IntegerCostModeMatchesFloatingCosts) {
+    Grid big(60, 60);
+    big.setCostScale(10.0, 14.0);
+    std::mt19937 rng(21);
+    scatterObstacles(big, rng, 5);
+
+    Node agent(0, 0);
+    Node goal(59, 59);
+
+    DStarLite floating(big);
+    DStarLite integer(big);
+    integer.setCostMode(CostMode::Integer);
+
+    std::vector<Node> correctPath = floating.findPath(agent, goal);
+    std::vector<Node> actualPath = integer.findPath(agent, goal);
+    ASSERT_FALSE(correctPath.empty());
+    EXPECT_EQ(pathCost(big, correctPath), pathCost(big, actualPath));
+
+    for (int step = 0; step < 40 && actualPath.size() > 1; step++) {
+        agent = actualPath[1];
+
+        std::vector<Node> changes;
+        for (int i = 0; i < 8; i++) {
+            Node node(rng() % 60, rng() % 60);
+            if (node == agent || node == goal) continue;
+            big.setWalkable(node, !big.isWalkable(node));
+            changes.push_back(node);
+        }
+
+        correctPath = floating.notifyEnvironmentChanges(agent, changes);
+        actualPath = integer.notifyEnvironmentChanges(agent, changes);
+
+        ASSERT_EQ(correctPath.empty(), actualPath.empty());
+        EXPECT_EQ(pathCost(big, correctPath), pathCost(big, actualPath));
+    }
+}
+
+TEST_F(DStarLiteTest, IrrelevantChangesSkipTheReplan) {
+    Grid big(40, 40);
+    DStarLite dstar(big);
+    std::vector<Node> path = dstar.findPath(Node(0, 0), Node(39, 39));
+    ASSERT_FALSE(path.empty());
+    long long expansions = dstar.stats().expansions;
+
+    // The far corner was never reached by the search.
+    Node far(0, 39);
+    big.setWalkable(far, false);
+    std::vector<Node> next = dstar.notifyEnvironmentChanges(path[1], {far});
+
+    EXPECT_EQ(next, std::vector<Node>(path.begin() + 1, path.end()));
+    EXPECT_EQ(dstar.stats().expansions, expansions);
+    EXPECT_EQ(dstar.stats().replansSkipped, 1);
+    EXPECT_EQ(dstar.stats().irrelevantChanges, 1);
+
+    // Blocking the path forces a real replan.
+    Node blocked = next[5];
+    big.setWalkable(blocked, false);
+    std::vector<Node> detour = dstar.notifyEnvironmentChanges(next[1], {blocked});
+
+    ASSERT_FALSE(detour.empty());
+    EXPECT_EQ(std::find(detour.begin(), detour.end(), blocked), detour.end());
+    EXPECT_EQ(dstar.stats().replansSkipped, 1);
+    EXPECT_EQ(dstar.stats().pathChanges, 1);
+    EXPECT_EQ(dstar.stats().replans, 2);
+}
+
+TEST_F(DStarLiteTest, SkippedReplansStayOptimal) {
+    Grid big(50, 50);
+    std::mt19937 rng(8);
+    scatterObstacles(big, rng, 6);
+
+    Node agent(0, 0);
+    Node goal(49, 49);
+
+    DStarLite dstar(big);
+    std::vector<Node> path = dstar.findPath(agent, goal);
+
+    for (int step = 0; step < 60 && path.size() > 1; step++) {
+        agent = path[1];
+
+        std::vector<Node> changes;
+        for (int i = 0; i < 3; i++) {
+            Node node(rng() % 50, rng() % 50);
+            if (node == agent || node == goal) continue;
+            big.setWalkable(node, !big.isWalkable(node));
+            changes.push_back(node);
+        }
+
+        path = dstar.notifyEnvironmentChanges(agent, changes);
+
+        DStarLite fresh(big);
+        std::vector<Node> expected = fresh.findPath(agent, goal);
+        ASSERT_EQ(expected.empty(), path.empty());
+        EXPECT_NEAR(pathCost(big, expected), pathCost(big, path), 1e-6);
+    }
+
+    EXPECT_GT(dstar.stats().replansSkipped, 0);
+    EXPECT_LT(dstar.stats().replansSkipped, dstar.stats().replans);
+}
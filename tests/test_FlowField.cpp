@@ -0,0 +1,168 @@
+#include "FlowField.h"
+#include "DStarLite.h"
+#include "Grid.h"
+#include "TestUtils.h"
+#include <queue>
+#include <random>
+#include <gtest/gtest.h>
+
+class FlowFieldTest : public ::testing::Test {
+protected:
+    // Plain Dijkstra from the goal over the grid's own edge costs.
+    static std::vector<double> dijkstra(const Grid& grid, const Node& goal) {
+        int rows = grid.getRows();
+        int cols = grid.getCols();
+        std::vector<double> dist(rows * cols, IGraph::INF_COST);
+        if (!grid.isWalkable(goal)) return dist;
+
+        using Entry = std::pair<double, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+        dist[goal.row * cols + goal.col] = 0.0;
+        open.emplace(0.0, goal.row * cols + goal.col);
+
+        while (!open.empty()) {
+            auto [d, cell] = open.top();
+            open.pop();
+            if (d > dist[cell]) continue;
+
+            Node node(cell / cols, cell % cols);
+            for (const Node& next : grid.getNeighbors(node)) {
+                double nd = d + grid.getEdgeCost(node, next);
+                int index = next.row * cols + next.col;
+                if (nd < dist[index]) {
+                    dist[index] = nd;
+                    open.emplace(nd, index);
+                }
+            }
+        }
+        return dist;
+    }
+
+    // Every cost matches Dijkstra and every reachable cell steps to a neighbour on an optimal path.
+    static void expectOptimal(const Grid& grid, const FlowField& field) {
+        std::vector<double> expected = dijkstra(grid, field.getGoal());
+        int cols = grid.getCols();
+
+        for (int cell = 0; cell < grid.getRows() * cols; cell++) {
+            Node node(cell / cols, cell % cols);
+            double cost = field.costs()[cell];
+
+            if (expected[cell] == IGraph::INF_COST) {
+                ASSERT_EQ(cost, IGraph::INF_COST) << node;
+                ASSERT_EQ(field.nextStep(node), node) << node;
+                continue;
+            }
+
+            ASSERT_NEAR(cost, expected[cell], 1e-9) << node;
+            if (node == field.getGoal()) continue;
+
+            Node next = field.nextStep(node);
+            ASSERT_NE(next, node) << node;
+            ASSERT_NEAR(grid.getEdgeCost(node, next) + field.cost(next), cost, 1e-9) << node;
+        }
+    }
+};
+
+TEST_F(FlowFieldTest, CostsMatchDijkstra) {
+    Grid grid(40, 40);
+    std::mt19937 rng(7);
+    for (int i = 0; i < 400; i++) grid.setWalkable(Node(rng() % 40, rng() % 40), false);
+    grid.setWalkable(Node(20, 20), true);
+
+    FlowField field(grid, Node(20, 20));
+
+    expectOptimal(grid, field);
+    EXPECT_DOUBLE_EQ(field.cost(Node(20, 20)), 0.0);
+    EXPECT_EQ(field.nextStep(Node(20, 20)), Node(20, 20));
+}
+
+TEST_F(FlowFieldTest, DirectionsArePackedThreeBitsPerCell) {
+    Grid grid(10, 10);
+    FlowField field(grid, Node(5, 5));
+
+    EXPECT_EQ(field.directions().size(), (100 + 20) / 21);
+
+    // Straight east of the goal the best move is west (index 3); cell 56 is word 2, slot 14.
+    std::uint64_t word = field.directions()[56 / FlowField::DIRECTIONS_PER_WORD];
+    EXPECT_EQ((word >> (3 * (56 % FlowField::DIRECTIONS_PER_WORD))) & 7u, 3u);
+    EXPECT_EQ(field.nextStep(Node(5, 6)), Node(5, 5));
+    EXPECT_EQ(field.nextStep(Node(0, 0)), Node(1, 1));
+}
+
+TEST_F(FlowFieldTest, AgentsFollowingTheFieldMatchDStarLite) {
+    Grid grid(30, 30);
+    for (int r = 0; r < 25; r++) grid.setWalkable(Node(r, 15), false);
+    Node goal(2, 28);
+    FlowField field(grid, goal);
+
+    for (const Node& start : {Node(0, 0), Node(29, 0), Node(10, 5)}) {
+        DStarLite dstar(grid);
+        std::vector<Node> path = dstar.findPath(start, goal);
+
+        Node agent = start;
+        double walked = 0.0;
+        for (int steps = 0; agent != goal && steps < 900; steps++) {
+            Node next = field.nextStep(agent);
+            walked += grid.getEdgeCost(agent, next);
+            agent = next;
+        }
+
+        EXPECT_EQ(agent, goal);
+        EXPECT_NEAR(walked, pathCost(grid, path), 1e-9);
+    }
+}
+
+TEST_F(FlowFieldTest, IncrementalUpdatesStayOptimal) {
+    Grid grid(40, 40);
+    std::mt19937 rng(11);
+    for (int i = 0; i < 300; i++) grid.setWalkable(Node(rng() % 40, rng() % 40), false);
+    grid.setWalkable(Node(5, 30), true);
+
+    FlowField field(grid, Node(5, 30));
+
+    for (int step = 0; step < 30; step++) {
+        std::vector<Node> changes;
+        for (int i = 0; i < 15; i++) {
+            Node node(rng() % 40, rng() % 40);
+            if (node == field.getGoal()) continue;
+            bool walkable = !grid.isWalkable(node);
+            grid.setWalkable(node, walkable);
+            changes.push_back(Node(node.row, node.col, walkable));
+        }
+
+        field.update(changes);
+        expectOptimal(grid, field);
+    }
+}
+
+TEST_F(FlowFieldTest, LocalChangesExpandFewCells) {
+    Grid grid(100, 100);
+    FlowField field(grid, Node(0, 0));
+    long long initial = field.expansions();
+    EXPECT_EQ(initial, 100 * 100);
+
+    // A wall near the far corner only moves the costs behind it.
+    std::vector<Node> changes;
+    for (int c = 90; c < 100; c++) {
+        grid.setWalkable(Node(95, c), false);
+        changes.push_back(Node(95, c, false));
+    }
+    field.update(changes);
+
+    EXPECT_LT(field.expansions() - initial, 500);
+    expectOptimal(grid, field);
+}
+
+TEST_F(FlowFieldTest, BlockedGoalAndNewGoal) {
+    Grid grid(12, 12);
+    FlowField field(grid, Node(6, 6));
+
+    grid.setWalkable(Node(6, 6), false);
+    field.update({ Node(6, 6, false) });
+    EXPECT_EQ(field.cost(Node(0, 0)), IGraph::INF_COST);
+    EXPECT_EQ(field.nextStep(Node(0, 0)), Node(0, 0));
+
+    field.setGoal(Node(0, 11));
+    expectOptimal(grid, field);
+    EXPECT_THROW(field.setGoal(Node(12, 0)), std::runtime_error);
+}
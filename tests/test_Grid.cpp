@@ -1,6 +1,9 @@
 #include "Grid.h"
 #include <cmath>
 #include <limits>
+#include <unordered_set>
+#include <random>
+#include <vector>
 #include <gtest/gtest.h>
 
 class GridTest : public ::testing::Test {
@@ -71,3 +74,112 @@ TEST_F(GridTest, DistanceWithObstacle) {
     grid.setWalkable(Node(1, 2), false);
     EXPECT_NEAR(grid.getEuclideanDistance(Node(0, 0), Node(1, 2)), std::sqrt(5), EPSILON);
 }
+
+TEST_F(GridTest, ReachabilityFollowsWalls) {
+    Grid big(70, 70);
+    for (int r = 0; r < 70; r++) big.setWalkable(Node(r, 40), false);
+    big.updateConnectivity();
+
+    EXPECT_FALSE(big.isReachable(Node(0, 0), Node(69, 69)));
+    EXPECT_TRUE(big.isReachable(Node(0, 0), Node(69, 39)));
+    EXPECT_FALSE(big.isReachable(Node(0, 0), Node(10, 40))); // blocked cells reach nothing
+
+    // A diagonal gap across a tile border is enough with 8-connectivity.
+    big.setWalkable(Node(31, 40), true);
+    big.updateConnectivity();
+    EXPECT_TRUE(big.isReachable(Node(0, 0), Node(69, 69)));
+    EXPECT_EQ(big.componentOf(Node(5, 5)), big.componentOf(Node(60, 60)));
+
+    big.setWalkable(Node(31, 40), false);
+    big.updateConnectivity();
+    EXPECT_FALSE(big.isReachable(Node(0, 0), Node(69, 69)));
+    EXPECT_EQ(big.componentOf(Node(10, 40)), -1);
+}
+
+TEST_F(GridTest, StaleIndexAnswersConservatively) {
+    Grid big(40, 40);
+    for (int r = 0; r < 40; r++) big.setWalkable(Node(r, 20), false);
+
+    EXPECT_TRUE(big.isReachable(Node(0, 0), Node(0, 39)));
+    EXPECT_THROW(big.componentOf(Node(0, 0)), std::runtime_error);
+
+    big.updateConnectivity();
+    EXPECT_FALSE(big.isReachable(Node(0, 0), Node(0, 39)));
+    EXPECT_NE(big.componentOf(Node(0, 0)), big.componentOf(Node(0, 39)));
+}
+
+TEST_F(GridTest, ReachabilityMatchesFloodFill) {
+    const int size = 90;
+    Grid big(size, size);
+    std::mt19937 rng(11);
+
+    // Large batches mostly rebuild the index, small ones mostly fold in incrementally.
+    for (int round = 0; round < 60; round++) {
+        int edits = round < 20 ? 400 : 1 + rng() % 8;
+        for (int i = 0; i < edits; i++) {
+            Node cell(rng() % size, rng() % size);
+            big.setWalkable(cell, rng() % 3 != 0);
+        }
+        big.updateConnectivity();
+
+        // Brute-force labels from a full flood fill.
+        std::vector<int> label(size * size, -1);
+        int labels = 0;
+        for (int cell = 0; cell < size * size; cell++) {
+            if (!big.isWalkable(Node(cell / size, cell % size)) || label[cell] != -1) continue;
+
+            std::vector<Node> stack = {Node(cell / size, cell % size)};
+            label[cell] = labels;
+            while (!stack.empty()) {
+                Node node = stack.back();
+                stack.pop_back();
+                for (const Node& neighbor : big.getNeighbors(node)) {
+                    int id = neighbor.row * size + neighbor.col;
+                    if (label[id] != -1) continue;
+                    label[id] = labels;
+                    stack.push_back(neighbor);
+                }
+            }
+            labels++;
+        }
+
+        for (int i = 0; i < 200; i++) {
+            int a = rng() % (size * size);
+            int b = rng() % (size * size);
+            bool expected = label[a] != -1 && label[a] == label[b];
+            EXPECT_EQ(big.isReachable(Node(a / size, a % size), Node(b / size, b % size)), expected);
+        }
+    }
+}
+
+TEST_F(GridTest, CostScale) {
+    grid.setCostScale(10.0, 14.0);
+    EXPECT_EQ(grid.getEdgeCost(Node(1, 1), Node(1, 2)), 10.0);
+    EXPECT_EQ(grid.getEdgeCost(Node(1, 1), Node(2, 2)), 14.0);
+    EXPECT_EQ(grid.getHeuristic(Node(0, 0), Node(3, 1)), 34.0); // one diagonal, two straight
+
+    EXPECT_THROW(grid.setCostScale(10.0, 25.0), std::runtime_error);
+    EXPECT_THROW(grid.setCostScale(0.0, 0.0), std::runtime_error);
+}
+
+TEST(NodeTest, PackedKeyIsUnique) {
+    EXPECT_NE(Node(1, 2).key(), Node(2, 1).key());
+    EXPECT_NE(Node(0, -1).key(), Node(-1, 0).key());
+    EXPECT_EQ(Node(3, 4).key(), Node(3, 4, false).key());
+}
+
+TEST(NodeTest, HashSpreadsGridCells) {
+    std::unordered_set<std::size_t> hashes;
+    for (int r = 0; r < 64; r++) 
+        for (int c = 0; c < 64; c++) 
+            hashes.insert(std::hash<Node>{}(Node(r, c)));
+
+    EXPECT_EQ(hashes.size(), 64 * 64);
+}
+
+TEST(NodeTest, LayerDistinguishesVoxels) {
+    EXPECT_NE(Node(1, 2, 0, true), Node(1, 2, 1, true));
+    EXPECT_EQ(Node(1, 2), Node(1, 2, 0, true));
+    EXPECT_EQ(Node(3, 4).spatialKey(), Node(3, 4).key());
+    EXPECT_NE(std::hash<Node>{}(Node(1, 2, 0, true)), std::hash<Node>{}(Node(1, 2, 1, true)));
+}
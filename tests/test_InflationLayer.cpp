@@ -0,0 +1,120 @@
+#include "InflationLayer.h"
+#include "DStarLite.h"
+#include "Grid.h"
+#include <random>
+#include <set>
+#include <gtest/gtest.h>
+
+class InflationLayerTest : public ::testing::Test {
+protected:
+    // Brute-force configuration space: blocked iff an obstacle lies within the radius.
+    static std::vector<char> bruteForce(const std::vector<char>& obstacles, int rows, int cols, double radius) {
+        std::vector<char> blocked(rows * cols, 0);
+        long long limit = static_cast<long long>(radius * radius);
+
+        for (int a = 0; a < rows * cols; a++) {
+            if (!obstacles[a]) continue;
+            for (int b = 0; b < rows * cols; b++) {
+                long long dr = a / cols - b / cols;
+                long long dc = a % cols - b % cols;
+                if (dr * dr + dc * dc <= limit) blocked[b] = 1;
+            }
+        }
+        return blocked;
+    }
+};
+
+TEST_F(InflationLayerTest, InflatesInitialObstacles) {
+    Grid grid(9, 9);
+    grid.setWalkable(Node(4, 4), false);
+
+    InflationLayer layer(grid, 1.5);
+
+    EXPECT_TRUE(layer.isObstacle(Node(4, 4)));
+    EXPECT_FALSE(grid.isWalkable(Node(3, 3)));
+    EXPECT_FALSE(grid.isWalkable(Node(4, 5)));
+    EXPECT_TRUE(grid.isWalkable(Node(4, 6)));
+    EXPECT_DOUBLE_EQ(layer.clearance(Node(4, 6)), 2.0);
+}
+
+TEST_F(InflationLayerTest, ChangeSetIsMinimal) {
+    Grid grid(20, 20);
+    grid.setWalkable(Node(10, 10), false);
+    InflationLayer layer(grid, 2.0);
+
+    // The new obstacle's disk overlaps the existing one; only the uncovered cells flip.
+    std::vector<Node> added = layer.update({ Node(10, 11, false) });
+    EXPECT_EQ(added.size(), 5);
+    for (const Node& node : added) {
+        EXPECT_FALSE(node.walkable);
+        EXPECT_FALSE(grid.isWalkable(node));
+    }
+
+    std::vector<Node> removed = layer.update({ Node(10, 10, true), Node(10, 11, true) });
+    EXPECT_EQ(removed.size(), 13 + 5);
+    for (const Node& node : removed) 
+        EXPECT_TRUE(grid.isWalkable(node));
+
+    EXPECT_TRUE(layer.update({ Node(0, 0, true) }).empty());
+}
+
+TEST_F(InflationLayerTest, MatchesBruteForce) {
+    const int rows = 30;
+    const int cols = 40;
+    std::mt19937 rng(7);
+
+    for (double radius : { 0.0, 1.0, 2.5, 4.2 }) {
+        Grid grid(rows, cols);
+        std::vector<char> obstacles(rows * cols, 0);
+        for (int i = 0; i < 40; i++) {
+            int cell = rng() % (rows * cols);
+            obstacles[cell] = 1;
+            grid.setWalkable(Node(cell / cols, cell % cols), false);
+        }
+
+        InflationLayer layer(grid, radius);
+        std::vector<char> expected = bruteForce(obstacles, rows, cols, radius);
+
+        for (int step = 0; step < 20; step++) {
+            std::vector<Node> changes;
+            for (int i = 0; i < 5; i++) {
+                int cell = rng() % (rows * cols);
+                obstacles[cell] = rng() % 2;
+                changes.push_back(Node(cell / cols, cell % cols, !obstacles[cell]));
+            }
+
+            std::vector<Node> reported = layer.update(changes);
+            std::vector<char> next = bruteForce(obstacles, rows, cols, radius);
+
+            std::set<int> flipped;
+            for (int cell = 0; cell < rows * cols; cell++) {
+                ASSERT_EQ(grid.isWalkable(Node(cell / cols, cell % cols)), !next[cell]) << "radius " << radius;
+                if (next[cell] != expected[cell]) flipped.insert(cell);
+            }
+
+            std::set<int> got;
+            for (const Node& node : reported) got.insert(node.row * cols + node.col);
+            EXPECT_EQ(got, flipped);
+            EXPECT_EQ(got.size(), reported.size());
+
+            expected = next;
+        }
+    }
+}
+
+TEST_F(InflationLayerTest, PlannerKeepsClearance) {
+    Grid grid(15, 15);
+    InflationLayer layer(grid, 1.0);
+    DStarLite dstar(grid);
+
+    Node start(7, 0);
+    Node goal(7, 14);
+    ASSERT_EQ(dstar.findPath(start, goal).size(), 15);
+
+    std::vector<Node> changes = layer.update({ Node(7, 7, false) });
+    std::vector<Node> path = dstar.notifyEnvironmentChanges(start, changes);
+
+    ASSERT_FALSE(path.empty());
+    for (const Node& node : path) 
+        EXPECT_GT(layer.clearance(node), 1.0);
+}
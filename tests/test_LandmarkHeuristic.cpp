@@ -0,0 +1,169 @@
+#include "LandmarkHeuristic.h"
+#include "DStarLite.h"
+#include "Grid.h"
+#include "TestUtils.h"
+#include <cmath>
+#include <random>
+#include <gtest/gtest.h>
+
+class LandmarkHeuristicTest : public ::testing::Test {
+protected:
+    inline static constexpr double EPSILON = 1e-6;
+
+    // Serpentine corridors: walls on every fourth row, open alternately at either end.
+    static void buildSerpentine(Grid& grid) {
+        for (int r = 2; r < grid.getRows() - 1; r += 4) {
+            bool openLeft = (r / 4) % 2 == 1;
+
+            for (int c = 0; c < grid.getCols(); c++) 
+                if (openLeft ? c > 1 : c < grid.getCols() - 2) 
+                    grid.setWalkable(Node(r, c), false);
+        }
+    }
+};
+
+TEST_F(LandmarkHeuristicTest, SelectsWalkableLandmarks) {
+    Grid grid(20, 20);
+    buildSerpentine(grid);
+
+    std::vector<Node> landmarks = LandmarkHeuristic::selectLandmarks(grid, 4);
+    ASSERT_EQ(landmarks.size(), 4);
+
+    for (const Node& landmark : landmarks) 
+        EXPECT_TRUE(grid.isWalkable(landmark));
+}
+
+TEST_F(LandmarkHeuristicTest, NeverBelowEuclidean) {
+    Grid grid(10, 10);
+    LandmarkHeuristic alt(grid, 3);
+
+    EXPECT_NEAR(alt.estimate(Node(2, 2), Node(2, 2)), 0.0, EPSILON);
+    EXPECT_GE(alt.estimate(Node(0, 0), Node(3, 4)) + EPSILON, 5.0);
+}
+
+TEST_F(LandmarkHeuristicTest, AdmissibleOnSerpentine) {
+    Grid grid(21, 21);
+    buildSerpentine(grid);
+    LandmarkHeuristic alt(grid, 4);
+
+    std::mt19937 rng(7);
+    for (int i = 0; i < 20; i++) {
+        Node a(rng() % 21, rng() % 21);
+        Node b(rng() % 21, rng() % 21);
+        if (!grid.isWalkable(a) || !grid.isWalkable(b)) continue;
+
+        DStarLite dstar(grid);
+        std::vector<Node> path = dstar.findPath(a, b);
+        ASSERT_FALSE(path.empty());
+        EXPECT_LE(alt.estimate(a, b), pathCost(grid, path) + EPSILON);
+    }
+}
+
+TEST_F(LandmarkHeuristicTest, ConsistentAcrossEdges) {
+    Grid grid(21, 21);
+    buildSerpentine(grid);
+    LandmarkHeuristic alt(grid, 4);
+    Node from(0, 0);
+
+    for (int r = 0; r < 21; r++) 
+        for (int c = 0; c < 21; c++) {
+            Node node(r, c);
+            if (!grid.isWalkable(node)) continue;
+
+            for (const Node& neighbor : grid.getNeighbors(node)) 
+                EXPECT_LE(alt.estimate(from, node), grid.getEdgeCost(node, neighbor) + alt.estimate(from, neighbor) + EPSILON);
+        }
+}
+
+TEST_F(LandmarkHeuristicTest, FewerExpansionsBehindWall) {
+    // Start and goal are neighbours across a wall that is only open at the bottom,
+    // so Euclidean distance badly underestimates the detour.
+    Grid grid(41, 41);
+    for (int r = 0; r < 40; r++) 
+        grid.setWalkable(Node(r, 20), false);
+
+    LandmarkHeuristic alt(grid, 4);
+
+    DStarLite euclidean(grid);
+    DStarLite landmark(grid);
+    landmark.setHeuristic(&alt);
+
+    std::vector<Node> euclideanPath = euclidean.findPath(Node(0, 19), Node(0, 21));
+    std::vector<Node> landmarkPath = landmark.findPath(Node(0, 19), Node(0, 21));
+
+    ASSERT_FALSE(landmarkPath.empty());
+    EXPECT_NEAR(pathCost(grid, euclideanPath), pathCost(grid, landmarkPath), EPSILON);
+    EXPECT_LT(landmark.stats().expansions * 3, euclidean.stats().expansions);
+}
+
+TEST_F(LandmarkHeuristicTest, OpeningShortcutRefreshesTables) {
+    Grid grid(21, 21);
+    buildSerpentine(grid);
+    LandmarkHeuristic alt(grid, 4);
+
+    DStarLite dstar(grid);
+    dstar.setHeuristic(&alt);
+    dstar.findPath(Node(0, 10), Node(4, 10));
+
+    // Punch a hole straight through the first wall.
+    grid.setWalkable(Node(2, 10), true);
+    EXPECT_TRUE(alt.notifyEnvironmentChanges({ Node(2, 10) }));
+    EXPECT_LE(alt.estimate(Node(0, 10), Node(4, 10)), 4.0 + EPSILON);
+
+    dstar.heuristicChanged();
+    std::vector<Node> path = dstar.notifyEnvironmentChanges(Node(0, 10), { Node(2, 10) });
+    EXPECT_NEAR(pathCost(grid, path), 4.0, EPSILON);
+}
+
+TEST_F(LandmarkHeuristicTest, ReopeningKnownCellsKeepsTables) {
+    Grid grid(21, 21);
+    buildSerpentine(grid);
+    LandmarkHeuristic alt(grid, 4);
+
+    // A door in open space closes and opens again: the tables already cover it.
+    grid.setWalkable(Node(0, 10), false);
+    EXPECT_FALSE(alt.notifyEnvironmentChanges({ Node(0, 10, false) }));
+    grid.setWalkable(Node(0, 10), true);
+    EXPECT_FALSE(alt.notifyEnvironmentChanges({ Node(0, 10) }));
+}
+
+TEST_F(LandmarkHeuristicTest, ReplansMatchFreshSearchUnderRandomEdits) {
+    Grid grid(40, 40);
+    std::mt19937 rng(5);
+    for (int i = 0; i < 40 * 40 / 4; i++) 
+        grid.setWalkable(Node(rng() % 40, rng() % 40), false);
+
+    Node agent(0, 0);
+    Node goal(39, 39);
+    grid.setWalkable(agent, true);
+    grid.setWalkable(goal, true);
+
+    LandmarkHeuristic alt(grid, 6);
+    DStarLite dstar(grid);
+    dstar.setHeuristic(&alt);
+    dstar.findPath(agent, goal);
+
+    int refreshes = 0;
+    for (int step = 0; step < 40; step++) {
+        std::vector<Node> changes;
+        for (int i = 0; i < 8; i++) {
+            Node cell(rng() % 40, rng() % 40);
+            if (cell == agent || cell == goal) continue;
+            bool walkable = !grid.isWalkable(cell);
+            grid.setWalkable(cell, walkable);
+            changes.push_back(Node(cell.row, cell.col, walkable));
+        }
+
+        if (alt.notifyEnvironmentChanges(changes)) {
+            dstar.heuristicChanged();
+            refreshes++;
+        }
+        std::vector<Node> path = dstar.notifyEnvironmentChanges(agent, changes);
+
+        DStarLite fresh(grid);
+        std::vector<Node> expected = fresh.findPath(agent, goal);
+        ASSERT_EQ(path.empty(), expected.empty());
+        EXPECT_NEAR(pathCost(grid, path), pathCost(grid, expected), EPSILON);
+    }
+    EXPECT_GT(refreshes, 0);
+}
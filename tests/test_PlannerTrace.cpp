@@ -0,0 +1,167 @@
+#include "PlannerTrace.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+class PlannerTraceTest : public ::testing::Test {
+protected:
+    std::string tempPath(const std::string& name) const {
+        return ::testing::TempDir() + name;
+    }
+
+    // Records a short mission and returns the paths the live planner produced.
+    std::vector<std::vector<Node>> recordMission(const std::string& path) {
+        Grid grid(30, 30);
+        std::mt19937 rng(4);
+        for (int i = 0; i < 120; i++) 
+            grid.setWalkable(Node(rng() % 30, rng() % 30), false);
+
+        Node agent(0, 0);
+        Node goal(29, 29);
+        grid.setWalkable(agent, true);
+        grid.setWalkable(goal, true);
+
+        DStarLite planner(grid);
+        TraceRecorder recorder(path, grid, planner);
+
+        std::vector<std::vector<Node>> paths = {recorder.findPath(agent, goal)};
+        for (int step = 0; step < 15 && paths.back().size() > 1; step++) {
+            agent = paths.back()[1];
+
+            std::vector<Node> changes;
+            for (int i = 0; i < 4; i++) {
+                Node node(rng() % 30, rng() % 30);
+                if (node == agent || node == goal) continue;
+
+                bool walkable = !grid.isWalkable(node);
+                recorder.setWalkable(node, walkable);
+                changes.push_back(Node(node.row, node.col, walkable));
+            }
+            paths.push_back(recorder.notifyEnvironmentChanges(agent, changes));
+        }
+
+        return paths;
+    }
+};
+
+TEST_F(PlannerTraceTest, RecordsEveryCall) {
+    std::string path = tempPath("events.dstr");
+    {
+        Grid grid(3, 4);
+        grid.setWalkable(Node(1, 2), false);
+        DStarLite planner(grid);
+
+        TraceRecorder recorder(path, grid, planner);
+        recorder.findPath(Node(0, 0), Node(2, 3));
+        recorder.setWalkable(Node(0, 1), false);
+        recorder.notifyEnvironmentChanges(Node(0, 0), {Node(0, 1, false)});
+        EXPECT_FALSE(grid.isWalkable(Node(0, 1))); // forwarded to the grid
+    }
+
+    PlannerTrace trace = PlannerTrace::load(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(trace.rows, 3);
+    EXPECT_EQ(trace.cols, 4);
+    EXPECT_FALSE(trace.walkable[1 * 4 + 2]);
+    EXPECT_TRUE(trace.walkable[0 * 4 + 1]);
+
+    ASSERT_EQ(trace.events.size(), 3u);
+    EXPECT_EQ(trace.events[0].type, TraceEvent::Type::FindPath);
+    EXPECT_EQ(trace.events[0].node, Node(0, 0));
+    EXPECT_EQ(trace.events[0].goal, Node(2, 3));
+    EXPECT_EQ(trace.events[1].type, TraceEvent::Type::SetWalkable);
+    EXPECT_EQ(trace.events[1].node, Node(0, 1));
+    EXPECT_FALSE(trace.events[1].node.walkable);
+    EXPECT_EQ(trace.events[2].type, TraceEvent::Type::Notify);
+    ASSERT_EQ(trace.events[2].changes.size(), 1u);
+    EXPECT_EQ(trace.events[2].changes[0], Node(0, 1));
+}
+
+TEST_F(PlannerTraceTest, ReplayReproducesTheRecordedSession) {
+    std::string path = tempPath("mission.dstr");
+    std::vector<std::vector<Node>> recorded = recordMission(path);
+    PlannerTrace trace = PlannerTrace::load(path);
+    std::remove(path.c_str());
+
+    TraceReplayer replayer(trace);
+    std::vector<ReplayCall> first = replayer.run();
+    std::vector<ReplayCall> second = replayer.run();
+
+    ASSERT_EQ(first.size(), recorded.size());
+    ASSERT_EQ(second.size(), recorded.size());
+    for (std::size_t i = 0; i < recorded.size(); i++) {
+        EXPECT_EQ(first[i].pathLength, recorded[i].size());
+        EXPECT_EQ(first[i].expansions, second[i].expansions);
+        EXPECT_EQ(first[i].stateSize, second[i].stateSize);
+    }
+    EXPECT_EQ(first.front().type, TraceEvent::Type::FindPath);
+    EXPECT_GT(first.front().expansions, 0);
+}
+
+TEST_F(PlannerTraceTest, ReplayAppliesConfiguration) {
+    std::string path = tempPath("configured.dstr");
+    recordMission(path);
+    PlannerTrace trace = PlannerTrace::load(path);
+    std::remove(path.c_str());
+
+    SearchArena arena;
+    TraceReplayer replayer(trace);
+    std::vector<ReplayCall> calls = replayer.run([](Grid& grid, DStarLite& planner) {
+        grid.setCostScale(10.0, 14.0);
+        planner.setCostMode(CostMode::Integer);
+    }, &arena);
+
+    ASSERT_FALSE(calls.empty());
+    EXPECT_GT(calls.front().pathLength, 0u);
+    EXPECT_GT(calls.front().arenaBytes, 0u);
+}
+
+TEST_F(PlannerTraceTest, RejectsForeignFiles) {
+    std::string path = tempPath("foreign.dstr");
+    std::ofstream(path, std::ios::binary) << "not a trace";
+
+    EXPECT_THROW(PlannerTrace::load(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(PlannerTrace::load(path), std::runtime_error);
+}
+
+TEST_F(PlannerTraceTest, RejectsCountsLargerThanTheFile) {
+    std::string path = tempPath("oversized.dstr");
+    {
+        Grid grid(2, 2);
+        DStarLite planner(grid);
+        TraceRecorder recorder(path, grid, planner);
+    }
+
+    // A Notify record claiming far more changes than the file holds.
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        std::uint8_t type = static_cast<std::uint8_t>(TraceEvent::Type::Notify);
+        std::int32_t coordinate = 0;
+        std::uint8_t walkable = 1;
+        std::uint32_t count = 0xFFFFFFFFu;
+        out.write(reinterpret_cast<const char*>(&type), sizeof(type));
+        out.write(reinterpret_cast<const char*>(&coordinate), sizeof(coordinate));
+        out.write(reinterpret_cast<const char*>(&coordinate), sizeof(coordinate));
+        out.write(reinterpret_cast<const char*>(&walkable), sizeof(walkable));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    EXPECT_THROW(PlannerTrace::load(path), std::runtime_error);
+
+    // A header whose grid needs more bitmap bytes than follow it.
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        std::uint32_t version = 1;
+        std::int32_t side = 1 << 20;
+        out.write("DSTR", 4);
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&side), sizeof(side));
+        out.write(reinterpret_cast<const char*>(&side), sizeof(side));
+    }
+    EXPECT_THROW(PlannerTrace::load(path), std::runtime_error);
+    std::remove(path.c_str());
+}
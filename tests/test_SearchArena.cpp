@@ -0,0 +1,150 @@
+#include "SearchArena.h"
+#include "DStarLite.h"
+#include "Grid.h"
+#include <cstdint>
+#include <unordered_map>
+#include <gtest/gtest.h>
+
+// Upstream resource that counts what the arena asks for.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    int allocations = 0;
+    int deallocations = 0;
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        deallocations++;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+TEST(SearchArenaTest, AllocationsAreAligned) {
+    SearchArena arena(256);
+
+    for (std::size_t alignment : {1, 2, 4, 8, 16, 32, 64}) {
+        void* p = arena.allocate(24, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0);
+    }
+}
+
+TEST(SearchArenaTest, SmallBlocksAreRecycled) {
+    SearchArena arena;
+
+    void* first = arena.allocate(40, 8);
+    arena.deallocate(first, 40, 8);
+    void* second = arena.allocate(40, 8);
+
+    EXPECT_EQ(first, second);
+}
+
+TEST(SearchArenaTest, ResetKeepsPeakCapacity) {
+    CountingResource upstream;
+    SearchArena arena(128, &upstream);
+
+    for (int i = 0; i < 100; i++) 
+        (void)arena.allocate(1000, 8);
+
+    std::size_t peak = arena.capacity();
+    EXPECT_GT(upstream.allocations, 1);
+
+    arena.reset();
+    EXPECT_EQ(arena.capacity(), peak);
+    EXPECT_EQ(arena.used(), 0);
+
+    int allocationsBefore = upstream.allocations;
+    for (int i = 0; i < 100; i++) 
+        (void)arena.allocate(1000, 8);
+
+    EXPECT_EQ(upstream.allocations, allocationsBefore);
+}
+
+TEST(SearchArenaTest, LargeBlocksAreRecycled) {
+    SearchArena arena;
+
+    void* first = arena.allocate(3000, 8);
+    std::size_t used = arena.used();
+    arena.deallocate(first, 3000, 8);
+
+    // Same power-of-two class, so the block comes back without growing the arena.
+    void* second = arena.allocate(4000, 8);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(arena.used(), used);
+}
+
+TEST(SearchArenaTest, PmrContainerUsesArena) {
+    SearchArena arena;
+    std::pmr::unordered_map<Node, double> costs(&arena);
+
+    for (int i = 0; i < 1000; i++) 
+        costs[Node(i, i)] = i;
+
+    EXPECT_GT(arena.used(), 1000 * sizeof(double));
+    EXPECT_EQ(costs[Node(500, 500)], 500.0);
+}
+
+TEST(SearchArenaTest, SteadyStateSearchesAllocateNothing) {
+    Grid grid(30, 30);
+    for (int r = 0; r < 25; r++) 
+        grid.setWalkable(Node(r, 15), false);
+
+    CountingResource upstream;
+    SearchArena arena(1024, &upstream);
+    DStarLite dstar(grid, &arena);
+    DStarLite reference(grid);
+
+    std::vector<Node> correctPath = reference.findPath(Node(0, 0), Node(0, 29));
+
+    // The first reset merges the chunks the first search spilled into.
+    EXPECT_EQ(correctPath, dstar.findPath(Node(0, 0), Node(0, 29)));
+    EXPECT_EQ(correctPath, dstar.findPath(Node(0, 0), Node(0, 29)));
+
+    int allocationsAfterWarmup = upstream.allocations;
+
+    for (int i = 0; i < 5; i++) 
+        EXPECT_EQ(correctPath, dstar.findPath(Node(0, 0), Node(0, 29)));
+
+    EXPECT_EQ(upstream.allocations, allocationsAfterWarmup);
+}
+
+TEST(SearchArenaTest, ReplanningWithArena) {
+    Grid grid(5, 5);
+    SearchArena arena;
+    DStarLite dstar(grid, &arena);
+
+    dstar.findPath(Node(0, 0), Node(4, 4));
+    grid.setWalkable(Node(2, 2), false);
+    std::vector<Node> actualPath = dstar.notifyEnvironmentChanges(Node(1, 1), { Node(2, 2) });
+
+    std::vector<Node> correctPath = { Node(1, 1), Node(1, 2), Node(2, 3), Node(3, 4), Node(4, 4) };
+    EXPECT_EQ(correctPath, actualPath);
+}
+
+TEST(SearchArenaTest, ReplansWithoutResetStayFlat) {
+    Grid grid(60, 60);
+    for (int r = 0; r < 50; r++) 
+        grid.setWalkable(Node(r, 30), false);
+
+    SearchArena arena;
+    DStarLite dstar(grid, &arena);
+    dstar.findPath(Node(0, 0), Node(0, 59));
+
+    // Toggling the cell at the end of the wall reroutes the path every time. Replans never
+    // reset the arena, so their temporaries must be recycled.
+    std::size_t warmedUp = 0;
+    for (int i = 0; i < 80; i++) {
+        Node cell(50, 30, i % 2 == 1);
+        grid.setWalkable(cell, cell.walkable);
+        dstar.notifyEnvironmentChanges(Node(0, 0), { cell });
+        if (i == 19) warmedUp = arena.used();
+    }
+
+    EXPECT_EQ(arena.used(), warmedUp);
+}
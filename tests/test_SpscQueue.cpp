@@ -0,0 +1,61 @@
+#include "SpscQueue.h"
+#include <thread>
+#include <gtest/gtest.h>
+
+TEST(SpscQueueTest, PushPopOrder) {
+    SpscQueue<int> queue(4);
+    EXPECT_TRUE(queue.isEmpty());
+
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_TRUE(queue.push(3));
+
+    int value = 0;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(SpscQueueTest, FullQueueRejectsPush) {
+    SpscQueue<int> queue(2);
+    EXPECT_EQ(queue.capacity(), 2);
+
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_FALSE(queue.push(3));
+
+    int value = 0;
+    queue.pop(value);
+    EXPECT_TRUE(queue.push(3)); // wraps around
+}
+
+TEST(SpscQueueTest, ProducerConsumerThreads) {
+    SpscQueue<int> queue(16);
+    const int total = 100000;
+
+    std::thread producer([&] {
+        for (int i = 0; i < total; i++) 
+            while (!queue.push(i)) std::this_thread::yield();
+    });
+
+    // Failures are only recorded here: returning early would leave the producer unjoined.
+    int outOfOrder = 0;
+    int expected = 0;
+    while (expected < total) {
+        int value;
+        if (queue.pop(value)) {
+            outOfOrder += value != expected;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_EQ(outOfOrder, 0);
+}
@@ -0,0 +1,105 @@
+#include "VoxelGrid.h"
+#include "DStarLite.h"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+
+class VoxelGridTest : public ::testing::Test {
+protected:
+    inline static constexpr double EPSILON = 1e-6;
+
+    // Blocks layer `layer` of the grid except for one hole.
+    template<typename G>
+    static void buildFloor(G& grid, int layer, const Node& hole) {
+        for (int r = 0; r < grid.getRows(); r++)
+            for (int c = 0; c < grid.getCols(); c++)
+                if (r != hole.row || c != hole.col) grid.setWalkable(Node(r, c, layer, false), false);
+    }
+
+    static bool contains(const std::vector<Node>& path, const Node& node) {
+        return std::find(path.begin(), path.end(), node) != path.end();
+    }
+};
+
+TEST_F(VoxelGridTest, SparseMapStoresOnlyOccupiedBricks) {
+    SparseVoxelMap map;
+
+    EXPECT_TRUE(map.setOccupied(3, 4, 5, true));
+    EXPECT_FALSE(map.setOccupied(3, 4, 5, true));
+    EXPECT_TRUE(map.setOccupied(-1, -9, 1000, true));
+    EXPECT_TRUE(map.isOccupied(-1, -9, 1000));
+    EXPECT_FALSE(map.isOccupied(-1, -9, 999));
+    EXPECT_EQ(map.brickCount(), 2);
+
+    map.setOccupied(-1, -9, 1000, false);
+    EXPECT_EQ(map.brickCount(), 1);
+    EXPECT_EQ(map.occupiedCount(), 1);
+}
+
+TEST_F(VoxelGridTest, PointCloudReturnsNewlyOccupiedVoxels) {
+    SparseVoxelMap map;
+    map.setOccupied(0, 0, 0, true);
+
+    std::vector<SparseVoxelMap::Point> cloud = {
+        {0.1, 0.1, 0.1},   // already occupied
+        {2.5, 1.2, 0.4},   // voxel (1, 2, 0)
+        {2.9, 1.9, 0.6},   // same voxel again
+        {-0.5, 0.0, 0.0}   // voxel (0, -1, 0)
+    };
+
+    std::vector<Node> changed = map.insertPoints(cloud, 1.0);
+
+    ASSERT_EQ(changed.size(), 2);
+    EXPECT_TRUE(contains(changed, Node(1, 2, 0, false)));
+    EXPECT_TRUE(contains(changed, Node(0, -1, 0, false)));
+    EXPECT_EQ(map.occupiedCount(), 3);
+}
+
+TEST_F(VoxelGridTest, NeighborCounts) {
+    VoxelGrid6 grid6(5, 5, 5);
+    VoxelGrid18 grid18(5, 5, 5);
+    VoxelGrid26 grid26(5, 5, 5);
+
+    EXPECT_EQ(grid6.getNeighbors(Node(2, 2, 2, true)).size(), 6);
+    EXPECT_EQ(grid18.getNeighbors(Node(2, 2, 2, true)).size(), 18);
+    EXPECT_EQ(grid26.getNeighbors(Node(2, 2, 2, true)).size(), 26);
+
+    EXPECT_EQ(grid6.getNeighbors(Node(0, 0, 0, true)).size(), 3);
+    EXPECT_EQ(grid18.getNeighbors(Node(0, 0, 0, true)).size(), 6);
+    EXPECT_EQ(grid26.getNeighbors(Node(0, 0, 0, true)).size(), 7);
+}
+
+TEST_F(VoxelGridTest, EdgeCostsAndHeuristic) {
+    VoxelGrid26 grid(5, 5, 5);
+    Node origin(1, 1, 1, true);
+
+    EXPECT_NEAR(grid.getEdgeCost(origin, Node(1, 1, 2, true)), 1.0, EPSILON);
+    EXPECT_NEAR(grid.getEdgeCost(origin, Node(2, 1, 2, true)), std::sqrt(2), EPSILON);
+    EXPECT_NEAR(grid.getEdgeCost(origin, Node(2, 2, 2, true)), std::sqrt(3), EPSILON);
+    EXPECT_NEAR(grid.getHeuristic(Node(0, 0, 0, true), Node(3, 2, 1, true)),
+                std::sqrt(3) + std::sqrt(2) + 1.0, EPSILON);
+}
+
+TEST_F(VoxelGridTest, PlansThroughHoleAndReplans) {
+    VoxelGrid26 grid(10, 10, 10);
+    buildFloor(grid, 5, Node(8, 8, 5, true));
+
+    DStarLite dstar(grid);
+    Node start(0, 0, 0, true);
+    Node goal(0, 0, 9, true);
+
+    std::vector<Node> path = dstar.findPath(start, goal);
+    ASSERT_FALSE(path.empty());
+    EXPECT_TRUE(contains(path, Node(8, 8, 5, true)));
+
+    // A scan closes the hole and the operator opens another one.
+    std::vector<Node> changes = grid.insertPoints({{8.5, 8.5, 5.5}}, 1.0);
+    std::vector<Node> opened = grid.applyChanges({Node(1, 1, 5, true)});
+    changes.insert(changes.end(), opened.begin(), opened.end());
+    ASSERT_EQ(changes.size(), 2);
+
+    path = dstar.notifyEnvironmentChanges(start, changes);
+    ASSERT_FALSE(path.empty());
+    EXPECT_TRUE(contains(path, Node(1, 1, 5, true)));
+    EXPECT_EQ(path.back(), goal);
+}